@@ -56,6 +56,14 @@ class abstract_channel : public ref_counted {
    */
   virtual void enqueue(mailbox_element_ptr what, execution_unit* host);
 
+  /**
+   * Enqueues all messages in `what` to the channel in order. Actors publish
+   * the whole batch to their mailbox with a single atomic operation and
+   * are rescheduled at most once. The default implementation calls
+   * `enqueue` for each element.
+   */
+  virtual void enqueue_batch(mailbox_batch what, execution_unit* host);
+
   /**
    * Returns the ID of the node this actor is running on.
    */
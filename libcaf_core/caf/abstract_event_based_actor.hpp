@@ -20,6 +20,7 @@
 #ifndef CAF_ABSTRACT_EVENT_BASED_ACTOR_HPP
 #define CAF_ABSTRACT_EVENT_BASED_ACTOR_HPP
 
+#include <deque>
 #include <type_traits>
 
 #include "caf/message_id.hpp"
@@ -77,11 +78,52 @@ class abstract_event_based_actor : public
     this->do_become(std::move(unbox(bhvr)), false);
   }
 
+  /**
+   * Switches to the behavior stored as `x.index`, which neither
+   * allocates memory nor modifies any reference count.
+   */
+  void become(named_behavior_t x) {
+    this->do_become_ref(named_behavior_at(x.index), true);
+  }
+
+  void become(const keep_behavior_t&, named_behavior_t x) {
+    this->do_become_ref(named_behavior_at(x.index), false);
+  }
+
   void unbecome() {
     this->m_bhvr_stack.pop_back();
   }
 
+  /**
+   * Stores `bhvr` as `name` for switching to it later via
+   * `become(named_behavior(name))`. Actors with a fixed set of states
+   * usually store all of them once in `make_behavior`. Replacing
+   * a stored behavior also replaces it on the behavior stack.
+   */
+  template <class T>
+  void set_behavior(T name, behavior_type bhvr) {
+    auto i = named_behavior(name).index;
+    if (i >= m_named_behaviors.size()) {
+      // growing a deque at the end keeps references to its elements valid
+      m_named_behaviors.resize(i + 1);
+    }
+    auto& x = m_named_behaviors[i];
+    if (x) {
+      // the old behavior might be running right now
+      this->m_bhvr_stack.retire(std::move(x));
+    }
+    x = std::move(unbox(bhvr));
+  }
+
  private:
+  behavior& named_behavior_at(size_t index) {
+    CAF_ASSERT(index < m_named_behaviors.size() && m_named_behaviors[index]);
+    return m_named_behaviors[index];
+  }
+
+  // the behavior stack refers to elements in this container
+  std::deque<behavior> m_named_behaviors;
+
   template <class... Ts>
   static behavior& unbox(typed_behavior<Ts...>& x) {
     return x.unbox();
@@ -117,6 +117,12 @@ using leave_atom = atom_constant<atom("LEAVE")>;
  */
 using forward_atom = atom_constant<atom("FORWARD")>;
 
+/**
+ * Signals the sender of a message that it has been discarded, because
+ * the mailbox of the receiver was full.
+ */
+using mailbox_full_atom = atom_constant<atom("MBOXFULL")>;
+
 } // namespace caf
 
 #endif // CAF_ATOM_HPP
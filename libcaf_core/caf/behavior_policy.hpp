@@ -20,6 +20,8 @@
 #ifndef CAF_BEHAVIOR_POLICY_HPP
 #define CAF_BEHAVIOR_POLICY_HPP
 
+#include <cstddef>
+
 namespace caf {
 
 struct keep_behavior_t {
@@ -35,6 +37,25 @@ struct keep_behavior_t {
  */
 constexpr keep_behavior_t keep_behavior = keep_behavior_t{};
 
+/**
+ * Refers to a behavior stored via {@link event_based_actor::set_behavior}.
+ * @relates local_actor
+ */
+struct named_behavior_t {
+  size_t index;
+};
+
+/**
+ * Refers to the behavior stored as `name` for passing it to
+ * {@link event_based_actor::become}, where `name` usually
+ * is an enumerator denoting a state of the actor.
+ * @relates local_actor
+ */
+template <class T>
+constexpr named_behavior_t named_behavior(T name) {
+  return named_behavior_t{static_cast<size_t>(name)};
+}
+
 } // namespace caf
 
 #endif // CAF_BEHAVIOR_POLICY_HPP
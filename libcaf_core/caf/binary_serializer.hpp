@@ -20,6 +20,7 @@
 #ifndef CAF_BINARY_SERIALIZER_HPP
 #define CAF_BINARY_SERIALIZER_HPP
 
+#include <vector>
 #include <utility>
 #include <sstream>
 #include <iomanip>
@@ -41,15 +42,21 @@ class binary_serializer : public serializer {
 
   using super = serializer;
 
+  friend class binary_writer;
+
  public:
 
   using write_fun = std::function<void(const char*, const char*)>;
 
+  using buffer_type = std::vector<char>;
+
   /**
    * Creates a binary serializer writing to given iterator position.
    */
   template <class OutIter>
-  binary_serializer(OutIter iter, actor_namespace* ns = nullptr) : super(ns) {
+  binary_serializer(OutIter iter, actor_namespace* ns = nullptr)
+      : super(ns),
+        m_buf(nullptr) {
     struct fun {
       fun(OutIter pos) : m_pos(pos) {}
       void operator()(const char* first, const char* last) {
@@ -60,6 +67,12 @@ class binary_serializer : public serializer {
     m_out = fun{iter};
   }
 
+  /**
+   * Creates a binary serializer appending to `buf`. Writes to `buf` directly
+   * rather than via a type-erased output function.
+   */
+  binary_serializer(buffer_type* buf, actor_namespace* ns = nullptr);
+
   void begin_object(const uniform_type_info* uti) override;
 
   void end_object() override;
@@ -72,8 +85,56 @@ class binary_serializer : public serializer {
 
   void write_raw(size_t num_bytes, const void* data) override;
 
+  bool writes_raw_integers() const override;
+
+  /**
+   * Writes `val` without boxing arithmetic values in a `primitive_variant`.
+   */
+  template <class T>
+  inline binary_serializer& write(const T& val) {
+    write_impl(val);
+    return *this;
+  }
+
+  template <class T>
+  inline binary_serializer& write(const T& val, const uniform_type_info* uti) {
+    uti->serialize(&val, this);
+    return *this;
+  }
+
  private:
 
+  inline void append(const char* first, const char* last) {
+    if (m_buf) {
+      m_buf->insert(m_buf->end(), first, last);
+    } else {
+      m_out(first, last);
+    }
+  }
+
+  template <class T>
+  typename std::enable_if<detail::is_raw_integer<T>::value>::type
+  write_impl(const T& val) {
+    auto first = reinterpret_cast<const char*>(&val);
+    append(first, first + sizeof(T));
+  }
+
+  template <class T>
+  typename std::enable_if<std::is_same<T, float>::value
+                          || std::is_same<T, double>::value>::type
+  write_impl(const T& val) {
+    write_impl(detail::pack754(val));
+  }
+
+  template <class T>
+  typename std::enable_if<!detail::is_raw_integer<T>::value
+                          && !std::is_same<T, float>::value
+                          && !std::is_same<T, double>::value>::type
+  write_impl(const T& val) {
+    write_value(val);
+  }
+
+  buffer_type* m_buf;
   write_fun m_out;
 
 };
@@ -81,8 +142,7 @@ class binary_serializer : public serializer {
 template <class T,
           class = typename std::enable_if<detail::is_primitive<T>::value>::type>
 binary_serializer& operator<<(binary_serializer& bs, const T& value) {
-  bs.write_value(value);
-  return bs;
+  return bs.write(value);
 }
 
 } // namespace caf
@@ -58,6 +58,26 @@ class abstract_uniform_type_info : public uniform_type_info {
     return create_impl<T>(other);
   }
 
+  size_t instance_size() const override {
+    return sizeof(T);
+  }
+
+  size_t instance_alignment() const override {
+    return alignof(T);
+  }
+
+  void construct(void* storage) const override {
+    new (storage) T();
+  }
+
+  void copy_construct(void* storage, const void* other) const override {
+    new (storage) T(deref(other));
+  }
+
+  void destroy(void* instance) const override {
+    deref(instance).~T();
+  }
+
  protected:
   abstract_uniform_type_info(std::string tname)
       : m_name(std::move(tname)),
@@ -82,7 +102,6 @@ class abstract_uniform_type_info : public uniform_type_info {
   std::string m_name;
   const std::type_info* m_native;
 
- private:
   template <class C>
   typename std::enable_if<std::is_empty<C>::value, bool>::type
   eq(const C&, const C&) const {
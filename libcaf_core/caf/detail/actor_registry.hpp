@@ -20,15 +20,14 @@
 #ifndef CAF_DETAIL_ACTOR_REGISTRY_HPP
 #define CAF_DETAIL_ACTOR_REGISTRY_HPP
 
-#include <map>
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <memory>
 #include <cstdint>
 #include <condition_variable>
 
 #include "caf/abstract_actor.hpp"
-#include "caf/detail/shared_spinlock.hpp"
 
 #include "caf/detail/singleton_mixin.hpp"
 
@@ -37,6 +36,13 @@ namespace detail {
 
 class singletons;
 
+/**
+ * Maps actor IDs to local actors. The registry is split into shards, each
+ * storing its entries in an open-addressing table. Lookups never lock,
+ * while insertions and removals lock only the affected shard. Entries are
+ * removed once their actor has exited, but each shard remembers the exit
+ * reasons of its most recently removed entries.
+ */
 class actor_registry : public singleton_mixin<actor_registry> {
  public:
   friend class singleton_mixin<actor_registry>;
@@ -50,6 +56,11 @@ class actor_registry : public singleton_mixin<actor_registry> {
    */
   using value_type = std::pair<abstract_actor_ptr, uint32_t>;
 
+  /**
+   * Returns the actor for `key` if it is still running. Otherwise, returns
+   * a nullptr along with the exit reason, which is `exit_reason::unknown`
+   * if the actor was never registered or is no longer remembered.
+   */
   value_type get_entry(actor_id key) const;
 
   // return nullptr if the actor wasn't put *or* finished execution
@@ -57,10 +68,15 @@ class actor_registry : public singleton_mixin<actor_registry> {
     return get_entry(key).first;
   }
 
+  // adds `value` unless `key` is already registered
   void put(actor_id key, const abstract_actor_ptr& value);
 
+  // removes `key` and remembers `reason` as its exit reason
   void erase(actor_id key, uint32_t reason);
 
+  // returns the number of registered actors
+  size_t size() const;
+
   // gets the next free actor id
   actor_id next_id();
 
@@ -76,18 +92,19 @@ class actor_registry : public singleton_mixin<actor_registry> {
   void await_running_count_equal(size_t expected);
 
  private:
-  using entries = std::map<actor_id, value_type>;
+  class shard;
 
   actor_registry();
 
+  shard& shard_for(actor_id key) const;
+
   std::atomic<size_t> m_running;
   std::atomic<actor_id> m_ids;
 
   std::mutex m_running_mtx;
   std::condition_variable m_running_cv;
 
-  mutable detail::shared_spinlock m_instances_mtx;
-  entries m_entries;
+  std::unique_ptr<shard[]> m_shards;
 };
 
 } // namespace detail
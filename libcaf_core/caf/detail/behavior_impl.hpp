@@ -21,6 +21,7 @@
 #define CAF_DETAIL_BEHAVIOR_IMPL_HPP
 
 #include <tuple>
+#include <vector>
 #include <type_traits>
 
 #include "caf/none.hpp"
@@ -79,6 +80,12 @@ class behavior_impl : public ref_counted {
 
   virtual void handle_timeout();
 
+  /**
+   * Returns whether a message with given type token
+   * might match one of the cases of this behavior.
+   */
+  virtual bool may_match(uint32_t type_token) const;
+
   inline const duration& timeout() const {
     return m_timeout;
   }
@@ -87,10 +94,44 @@ class behavior_impl : public ref_counted {
 
   pointer or_else(const pointer& other);
 
+  /**
+   * Behaviors with at least this many cases dispatch messages via
+   * a table instead of testing each case in order.
+   */
+  static constexpr size_t dispatch_threshold = 8;
+
  protected:
+  /**
+   * Builds the dispatch table for `[m_begin, m_end)`. Subtypes call this
+   * member function once after initializing both pointers.
+   */
+  void init_dispatch_table();
+
   duration m_timeout;
   match_case_info* m_begin;
   match_case_info* m_end;
+
+ private:
+  // maps a type token and, for cases starting with a known atom, the
+  // leading atom to the range of cases in m_candidates that can match
+  struct dispatch_entry {
+    uint32_t type_token;
+    bool has_atom;
+    atom_value atom;
+    uint32_t first;
+    uint32_t last;
+  };
+
+  using candidate_range = std::pair<match_case_info* const*,
+                                    match_case_info* const*>;
+
+  candidate_range candidates(uint32_t type_token, const message& msg) const;
+
+  std::vector<dispatch_entry> m_dispatch;
+  // starts with all cases containing wildcards, which is the
+  // fallback for type tokens without entry in m_dispatch
+  std::vector<match_case_info*> m_candidates;
+  uint32_t m_num_wildcards;
 };
 
 template <size_t Pos, size_t Size>
@@ -145,6 +186,7 @@ class default_behavior_impl : public behavior_impl {
     defaut_bhvr_impl_init<0, num_cases>::init(m_arr, m_cases);
     m_begin = m_arr.data();
     m_end = m_begin + m_arr.size();
+    init_dispatch_table();
   }
 
   Tuple m_cases;
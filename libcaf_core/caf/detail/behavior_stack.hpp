@@ -57,11 +57,23 @@ class behavior_stack {
 
   inline behavior& back() {
     CAF_ASSERT(!empty());
-    return m_elements.back();
+    auto& x = m_elements.back();
+    return x.second ? *x.second : x.first;
   }
 
   inline void push_back(behavior&& what) {
-    m_elements.emplace_back(std::move(what));
+    m_elements.emplace_back(std::move(what), nullptr);
+  }
+
+  // pushes a behavior without taking ownership, i.e., the caller
+  // guarantees that `what` outlives its use on this stack
+  inline void push_back_ref(behavior& what) {
+    m_elements.emplace_back(behavior{}, &what);
+  }
+
+  // keeps `what` alive until the next call to `cleanup`
+  inline void retire(behavior&& what) {
+    m_erased_elements.push_back(std::move(what));
   }
 
   inline void cleanup() {
@@ -69,7 +81,8 @@ class behavior_stack {
   }
 
  private:
-  std::vector<behavior> m_elements;
+  // elements either own their behavior or point to one
+  std::vector<std::pair<behavior, behavior*>> m_elements;
   std::vector<behavior> m_erased_elements;
 };
 
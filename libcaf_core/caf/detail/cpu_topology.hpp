@@ -0,0 +1,107 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_CPU_TOPOLOGY_HPP
+#define CAF_DETAIL_CPU_TOPOLOGY_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace caf {
+namespace detail {
+
+/**
+ * Location of a logical CPU in the machine.
+ */
+struct cpu_info {
+  int id;
+  int core;
+  int package;
+  int node;
+};
+
+/**
+ * Describes the logical CPUs of this machine as reported by sysfs and
+ * assigns workers to CPUs. The topology is empty on platforms without
+ * sysfs, in which case workers are neither pinned nor grouped.
+ */
+class cpu_topology {
+ public:
+  /**
+   * Returns the topology of this machine, read once from sysfs and
+   * restricted to the CPUs this process may run on.
+   */
+  static const cpu_topology& instance();
+
+  /**
+   * Reads the topology from `root`, e.g., `/sys/devices/system`.
+   */
+  static cpu_topology read(const std::string& root);
+
+  /**
+   * Reads the topology from `root` but only includes CPUs in `allowed`,
+   * whereas an empty list includes all online CPUs.
+   */
+  static cpu_topology read(const std::string& root,
+                           const std::vector<int>& allowed);
+
+  /**
+   * Returns the CPUs in the affinity mask of this process, e.g., as set
+   * by `taskset` or a cgroup cpuset, or an empty list on error.
+   */
+  static std::vector<int> allowed_cpus();
+
+  /**
+   * Returns all logical CPUs in placement order, i.e., one CPU per core
+   * (grouped by NUMA node) before SMT siblings of already used cores.
+   */
+  inline const std::vector<cpu_info>& cpus() const {
+    return m_cpus;
+  }
+
+  inline bool empty() const {
+    return m_cpus.empty();
+  }
+
+  /**
+   * Returns the CPU for worker `id` or `nullptr` if the topology is empty.
+   */
+  const cpu_info* placement(size_t id) const;
+
+  /**
+   * Groups all workers except `id` by their distance to `id`: workers on
+   * the same core, workers on the same NUMA node and remote workers.
+   */
+  std::vector<std::vector<size_t>> steal_tiers(size_t id,
+                                               size_t num_workers) const;
+
+  /**
+   * Binds the calling thread to `cpu`, returns `false` on error.
+   */
+  static bool pin_this_thread(int cpu);
+
+ private:
+  std::vector<cpu_info> m_cpus;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_CPU_TOPOLOGY_HPP
@@ -127,7 +127,7 @@ class default_serialize_policy {
  private:
   template <class T>
   void simpl(const T& val, serializer* s, primitive_impl) const {
-    s->write_value(val);
+    s->write(val);
   }
 
   template <class T>
@@ -273,6 +273,11 @@ class member_tinfo : public detail::abstract_uniform_type_info<T> {
     ds(vptr, d, token);
   }
 
+  // `lhs` and `rhs` point to the enclosing objects, not to the members
+  bool equals(const void* lhs, const void* rhs) const override {
+    return this->eq(m_apol(lhs), m_apol(rhs));
+  }
+
  private:
 
   void ds(void* p, deserializer* d, std::true_type) const {
@@ -351,6 +356,10 @@ class member_tinfo<T, AccessPolicy, SerializePolicy, true, false>
     m_apol(p, static_cast<T>(tmp));
   }
 
+  bool equals(const void* lhs, const void* rhs) const override {
+    return m_apol(lhs) == m_apol(rhs);
+  }
+
  private:
   AccessPolicy m_apol;
   SerializePolicy m_spol;
@@ -476,16 +485,33 @@ class default_uniform_type_info : public detail::abstract_uniform_type_info<T> {
 
   template <class... Ts>
   default_uniform_type_info(std::string tname, Ts&&... xs)
-      : super(std::move(tname)) {
+      : super(std::move(tname)),
+        m_raw_size(0),
+        m_raw_contiguous(true) {
     push_back(std::forward<Ts>(xs)...);
   }
 
-  default_uniform_type_info(std::string tname) : super(std::move(tname)) {
+  default_uniform_type_info(std::string tname)
+      : super(std::move(tname)),
+        m_raw_size(0),
+        m_raw_contiguous(true) {
     using result_type = member_tinfo<T, fake_access_policy<T>>;
     m_members.push_back(uniform_type_info_ptr(new result_type));
   }
 
   void serialize(const void* obj, serializer* s) const override {
+    if (m_raw_members.size() == m_members.size() && s->writes_raw_integers()) {
+      // all members are integers, i.e., we can copy their representation
+      auto bytes = reinterpret_cast<const char*>(obj);
+      if (m_raw_contiguous) {
+        s->write_raw(m_raw_size, bytes + m_raw_members.front().first);
+        return;
+      }
+      for (auto& m : m_raw_members) {
+        s->write_raw(m.second, bytes + m.first);
+      }
+      return;
+    }
     // serialize each member
     for (auto& m : m_members) {
       m->serialize(obj, s);
@@ -526,17 +552,45 @@ class default_uniform_type_info : public detail::abstract_uniform_type_info<T> {
 
   template <class R, class C, class... Ts>
   void push_back(R C::*memptr, Ts&&... xs) {
-    m_members.push_back(new_member_tinfo(memptr));
+    // `C` can be a base class of `T`, but we always access members
+    // through a pointer to `T`
+    R T::*ptr = memptr;
+    m_members.push_back(new_member_tinfo(ptr));
+    std::integral_constant<bool, is_raw_integer<R>::value> token;
+    add_raw_member(ptr, token);
     push_back(std::forward<Ts>(xs)...);
   }
 
+  // stores offset and size of integer members, `C` is always `T`
+  template <class R, class C>
+  void add_raw_member(R C::*memptr, std::true_type) {
+    typename std::aligned_storage<sizeof(C), alignof(C)>::type storage;
+    auto obj = reinterpret_cast<const C*>(&storage);
+    auto first = reinterpret_cast<const char*>(obj);
+    auto member = reinterpret_cast<const char*>(&(obj->*memptr));
+    auto offset = static_cast<size_t>(member - first);
+    if (!m_raw_members.empty()) {
+      auto& last = m_raw_members.back();
+      m_raw_contiguous = m_raw_contiguous
+                         && last.first + last.second == offset;
+    }
+    m_raw_members.emplace_back(offset, sizeof(R));
+    m_raw_size += sizeof(R);
+  }
+
+  template <class R, class C>
+  void add_raw_member(R C::*, std::false_type) {
+    // nop
+  }
+
   // pr.first = member pointer
   // pr.second = meta object to handle pr.first
   template <class R, class C, class... Ts>
   void push_back(const std::pair<R C::*,
                                  detail::abstract_uniform_type_info<R>*>& pr,
                  Ts&&... xs) {
-    m_members.push_back(new_member_tinfo(pr.first,
+    R T::*ptr = pr.first;
+    m_members.push_back(new_member_tinfo(ptr,
                                          uniform_type_info_ptr(pr.second)));
     push_back(std::forward<Ts>(xs)...);
   }
@@ -567,6 +621,10 @@ class default_uniform_type_info : public detail::abstract_uniform_type_info<T> {
   }
 
   std::vector<uniform_type_info_ptr> m_members;
+  // offset and size of each integer member accessed via member pointer
+  std::vector<std::pair<size_t, size_t>> m_raw_members;
+  size_t m_raw_size;
+  bool m_raw_contiguous;
 };
 
 template <class... Sigs>
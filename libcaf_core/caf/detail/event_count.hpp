@@ -0,0 +1,152 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_EVENT_COUNT_HPP
+#define CAF_DETAIL_EVENT_COUNT_HPP
+
+#include "caf/config.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+
+#ifdef CAF_LINUX
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace caf {
+namespace detail {
+
+/**
+ * An event count allows threads to wait for a condition without a lock
+ * protecting that condition. A waiter announces itself via `prepare_wait`,
+ * re-checks its condition and then either calls `cancel_wait` or blocks
+ * in `wait`. A notifier makes its change visible before calling
+ * `notify_one` or `notify_all`, which cost only a fence and an atomic load
+ * while nobody waits. Uses a futex on Linux and a condition variable
+ * elsewhere.
+ */
+class event_count {
+ public:
+  using key_type = uint32_t;
+
+  event_count() : m_epoch(0), m_waiters(0) {
+    // nop
+  }
+
+  event_count(const event_count&) = delete;
+  event_count& operator=(const event_count&) = delete;
+
+  /**
+   * Announces the calling thread as waiter. The caller must check its
+   * condition afterwards and then call either `cancel_wait` or `wait`.
+   */
+  key_type prepare_wait() {
+    m_waiters.fetch_add(1, std::memory_order_seq_cst);
+    return m_epoch.load(std::memory_order_seq_cst);
+  }
+
+  /**
+   * Withdraws a previous `prepare_wait`.
+   */
+  void cancel_wait() {
+    m_waiters.fetch_sub(1, std::memory_order_seq_cst);
+  }
+
+  /**
+   * Blocks until a notification arrived after the call to `prepare_wait`
+   * that returned `key`.
+   */
+  void wait(key_type key) {
+#   ifdef CAF_LINUX
+    while (m_epoch.load(std::memory_order_acquire) == key) {
+      ::syscall(SYS_futex, futex_addr(), FUTEX_WAIT_PRIVATE, key,
+                nullptr, nullptr, 0);
+    }
+#   else
+    std::unique_lock<std::mutex> guard{m_mtx};
+    while (m_epoch.load(std::memory_order_acquire) == key) {
+      m_cv.wait(guard);
+    }
+#   endif
+    m_waiters.fetch_sub(1, std::memory_order_seq_cst);
+  }
+
+  /**
+   * Wakes up one waiting thread if any.
+   */
+  void notify_one() {
+    notify(false);
+  }
+
+  /**
+   * Wakes up all waiting threads.
+   */
+  void notify_all() {
+    notify(true);
+  }
+
+ private:
+  void notify(bool all) {
+    // orders the caller's change before reading the number of waiters;
+    // pairs with the read-modify-write in `prepare_wait`
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+#   ifdef CAF_LINUX
+    m_epoch.fetch_add(1, std::memory_order_seq_cst);
+    ::syscall(SYS_futex, futex_addr(), FUTEX_WAKE_PRIVATE, all ? INT32_MAX : 1,
+              nullptr, nullptr, 0);
+#   else
+    { // lifetime scope of guard
+      std::lock_guard<std::mutex> guard{m_mtx};
+      m_epoch.fetch_add(1, std::memory_order_seq_cst);
+    }
+    if (all) {
+      m_cv.notify_all();
+    } else {
+      m_cv.notify_one();
+    }
+#   endif
+  }
+
+# ifdef CAF_LINUX
+  int* futex_addr() {
+    static_assert(sizeof(std::atomic<key_type>) == sizeof(int),
+                  "futex requires a 32-bit atomic without extra state");
+    return reinterpret_cast<int*>(&m_epoch);
+  }
+# endif
+
+  std::atomic<key_type> m_epoch;
+  std::atomic<uint32_t> m_waiters;
+# ifndef CAF_LINUX
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+# endif
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_EVENT_COUNT_HPP
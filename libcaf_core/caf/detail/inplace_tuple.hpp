@@ -0,0 +1,104 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_INPLACE_TUPLE_HPP
+#define CAF_DETAIL_INPLACE_TUPLE_HPP
+
+#include "caf/intrusive_ptr.hpp"
+#include "caf/uniform_type_info.hpp"
+
+#include "caf/detail/message_data.hpp"
+
+namespace caf {
+namespace detail {
+
+/**
+ * A tuple with dynamic types that stores all elements along with the
+ * tuple itself in a single memory block. Elements are constructed in
+ * place via their `uniform_type_info`, which allows deserializers to
+ * read each value directly into its final position.
+ */
+class inplace_tuple : public message_data {
+ public:
+  inplace_tuple& operator=(const inplace_tuple&) = delete;
+
+  using types_iterator = const uniform_type_info* const*;
+
+  /**
+   * Checks whether all types in `[first, last)` support
+   * construction in place.
+   */
+  static bool supported(types_iterator first, types_iterator last);
+
+  /**
+   * Creates a tuple with default-constructed elements of types `[first, last)`.
+   * @pre `supported(first, last)`
+   */
+  static intrusive_ptr<inplace_tuple> make(types_iterator first,
+                                           types_iterator last);
+
+  void request_deletion(bool decremented_rc) noexcept override;
+
+  void* mutable_at(size_t pos) override;
+
+  size_t size() const override;
+
+  cow_ptr copy() const override;
+
+  const void* at(size_t pos) const override;
+
+  bool match_element(size_t pos, uint16_t typenr,
+                     const std::type_info* rtti) const override;
+
+  uint32_t type_token() const override;
+
+  const char* uniform_name_at(size_t pos) const override;
+
+  uint16_t type_nr_at(size_t pos) const override;
+
+ private:
+  struct element {
+    const uniform_type_info* type;
+    void* value;
+  };
+
+  inplace_tuple(size_t size);
+
+  ~inplace_tuple();
+
+  // allocates a tuple and assigns storage to each element
+  // without constructing any value
+  static inplace_tuple* allocate(types_iterator first, types_iterator last);
+
+  inline element* elements() {
+    return reinterpret_cast<element*>(this + 1);
+  }
+
+  inline const element* elements() const {
+    return reinterpret_cast<const element*>(this + 1);
+  }
+
+  size_t m_size;
+  uint32_t m_type_token;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_INPLACE_TUPLE_HPP
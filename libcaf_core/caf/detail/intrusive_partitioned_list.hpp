@@ -203,6 +203,17 @@ class intrusive_partitioned_list {
   template <class Actor>
   bool invoke(Actor* self, iterator first, iterator last,
               behavior& bhvr, message_id mid) {
+    nop_observer obs;
+    return invoke(self, first, last, bhvr, mid, obs);
+  }
+
+  /**
+   * Invokes `bhvr` for each element in `[first, last)` accepted by `obs`
+   * and notifies `obs` whenever an element leaves or re-enters the list.
+   */
+  template <class Actor, class Observer>
+  bool invoke(Actor* self, iterator first, iterator last,
+              behavior& bhvr, message_id mid, Observer& obs) {
     pointer prev = first->prev;
     pointer next = first->next;
     auto move_on = [&](bool first_valid) {
@@ -213,6 +224,10 @@ class intrusive_partitioned_list {
       next = first->next;
     };
     while (first != last) {
+      if (!obs.accepts(*first)) {
+        move_on(true);
+        continue;
+      }
       std::unique_ptr<value_type, deleter_type> tmp{first.ptr};
       // since this function can be called recursively during
       // self->invoke_message(tmp, xs...), we have to remove the
@@ -220,6 +235,7 @@ class intrusive_partitioned_list {
       // it's safe, i.e., if invoke_message returned im_skipped
       prev->next = next;
       next->prev = prev;
+      obs.taken(*tmp);
       switch (self->invoke_message(tmp, bhvr, mid)) {
         case im_dropped:
           move_on(false);
@@ -229,6 +245,7 @@ class intrusive_partitioned_list {
         case im_skipped:
           if (tmp) {
             // re-integrate tmp and move on
+            obs.restored(*tmp);
             prev->next = tmp.get();
             next->prev = tmp.release();
             move_on(true);
@@ -259,6 +276,20 @@ class intrusive_partitioned_list {
   }
 
  private:
+  struct nop_observer {
+    bool accepts(const value_type&) const {
+      return true;
+    }
+
+    void taken(const value_type&) {
+      // nop
+    }
+
+    void restored(const value_type&) {
+      // nop
+    }
+  };
+
   value_type m_head;
   value_type m_separator;
   value_type m_tail;
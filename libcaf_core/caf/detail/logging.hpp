@@ -21,6 +21,7 @@
 #define CAF_LOGGING_HPP
 
 #include <thread>
+#include <memory>
 #include <cstring>
 #include <sstream>
 #include <iostream>
@@ -64,19 +65,22 @@ class logging {
   // returns the previously set actor id
   actor_id set_aid(actor_id aid);
 
+  // enqueues a log event to a ring buffer of the calling thread; all
+  // arguments except `msg` must have static storage duration, because
+  // a background thread formats events in batches
   virtual void log(const char* level, const char* class_name,
                    const char* function_name, const char* file_name,
                    int line_num, const std::string& msg) = 0;
 
   class trace_helper {
    public:
-    trace_helper(std::string class_name, const char* fun_name,
+    trace_helper(const char* class_name, const char* fun_name,
                  const char* file_name, int line_num, const std::string& msg);
 
     ~trace_helper();
 
    private:
-    std::string m_class;
+    const char* m_class;
     const char* m_fun_name;
     const char* m_file_name;
     int m_line_num;
@@ -100,39 +104,123 @@ class logging {
   std::unordered_map<std::thread::id, actor_id> m_aids;
 };
 
-struct oss_wr {
-  inline oss_wr() {
-    // nop
+// builds log messages in a buffer of the calling thread, i.e., without
+// allocating once the buffer reached its working size; nested messages,
+// e.g., built while converting an argument, fall back to a local string;
+// arguments bypass the stream unless a manipulator changed its format
+class oss_wr {
+ public:
+  oss_wr();
+
+  ~oss_wr();
+
+  oss_wr(const oss_wr&) = delete;
+  oss_wr& operator=(const oss_wr&) = delete;
+
+  inline const std::string& str() const {
+    return *m_str;
   }
 
-  inline oss_wr(oss_wr&& other) : m_str(std::move(other.m_str)) {
-    // nop
+  inline oss_wr& operator<<(const std::string& x) {
+    if (m_formatted) {
+      return formatted(x);
+    }
+    m_str->append(x);
+    return *this;
   }
 
-  std::string m_str;
+  inline oss_wr& operator<<(const char* x) {
+    if (m_formatted) {
+      return formatted(x);
+    }
+    m_str->append(x);
+    return *this;
+  }
 
-  inline std::string str() {
-    return std::move(m_str);
+  inline oss_wr& operator<<(char x) {
+    if (m_formatted) {
+      return formatted(x);
+    }
+    m_str->push_back(x);
+    return *this;
+  }
+
+  inline oss_wr& operator<<(bool x) {
+    if (m_formatted) {
+      return formatted(x);
+    }
+    m_str->append(x ? "true" : "false");
+    return *this;
+  }
+
+  inline oss_wr& operator<<(std::ostream& (*f)(std::ostream&)) {
+    return formatted(f);
+  }
+
+  inline oss_wr& operator<<(std::ios_base& (*f)(std::ios_base&)) {
+    return formatted(f);
+  }
+
+  template <class T>
+  oss_wr& operator<<(const T& x) {
+    static constexpr int kind = std::is_integral<T>::value
+                                && sizeof(T) > sizeof(char)
+                                ? (std::is_signed<T>::value ? 0 : 1)
+                                : (std::is_floating_point<T>::value ? 2 : 3);
+    if (m_formatted) {
+      return formatted(x);
+    }
+    append(x, std::integral_constant<int, kind>{});
+    return *this;
+  }
+
+ private:
+  template <class T>
+  void append(T x, std::integral_constant<int, 0>) {
+    append_int(static_cast<long long>(x));
+  }
+
+  template <class T>
+  void append(T x, std::integral_constant<int, 1>) {
+    append_uint(static_cast<unsigned long long>(x));
   }
-};
 
-inline oss_wr operator<<(oss_wr&& lhs, std::string str) {
-  lhs.m_str += std::move(str);
-  return std::move(lhs);
-}
+  template <class T>
+  void append(T x, std::integral_constant<int, 2>) {
+    append_double(static_cast<double>(x));
+  }
+
+  template <class T>
+  void append(const T& x, std::integral_constant<int, 3>) {
+    formatted(x);
+  }
 
-inline oss_wr operator<<(oss_wr&& lhs, const char* str) {
-  lhs.m_str += str;
-  return std::move(lhs);
-}
+  // writes `x` to the stream, which applies all manipulators, e.g.,
+  // `std::hex` or `std::setw`, and checks whether any is still in effect
+  template <class T>
+  oss_wr& formatted(const T& x) {
+    stream() << x;
+    m_formatted = !has_default_format();
+    return *this;
+  }
 
-template <class T>
-oss_wr operator<<(oss_wr&& lhs, T rhs) {
-  std::ostringstream oss;
-  oss << rhs;
-  lhs.m_str += oss.str();
-  return std::move(lhs);
-}
+  bool has_default_format();
+
+  void append_int(long long x);
+
+  void append_uint(unsigned long long x);
+
+  void append_double(double x);
+
+  // returns a stream writing to `m_str`
+  std::ostream& stream();
+
+  std::string* m_str;
+  bool m_shared;
+  bool m_formatted;
+  std::string m_fallback;
+  std::unique_ptr<std::ostream> m_fallback_stream;
+};
 
 } // namespace detail
 } // namespace caf
@@ -179,7 +267,6 @@ inline caf::actor_id caf_set_aid_dummy() { return 0; }
   caf::detail::singletons::get_logger()->log(lvlname, classname, funname,      \
                                              __FILE__, __LINE__,               \
                                              (caf::detail::oss_wr{}            \
-                                              << std::boolalpha                \
                                               << message).str())
 #define CAF_PUSH_AID(aid_arg)                                                  \
   auto CAF_UNIFYN(caf_aid_tmp)                                                 \
@@ -215,7 +302,7 @@ inline caf::actor_id caf_set_aid_dummy() { return 0; }
 #define CAF_PRINT4(lvlname, classname, funname, msg)                           \
   caf::detail::logging::trace_helper CAF_UNIFYN(caf_log_trace_)  {             \
     classname, funname, __FILE__, __LINE__,                                    \
-      (caf::detail::oss_wr{} << msg).str()                                     \
+      (caf::detail::oss_wr{} << "ENTRY " << msg).str()                         \
   }
 #endif
 
@@ -243,7 +330,9 @@ inline caf::actor_id caf_set_aid_dummy() { return 0; }
 
 /**
  * @def CAF_LOGC
- * Logs a message with custom class and function names.
+ * Logs a message with custom class and function names. Both names must
+ * have static storage duration, e.g., string literals or the result of
+ * `typeid(...).name()`, because the logger formats records asynchronously.
  */
 #define CAF_LOGC(level, classname, funname, msg)                               \
   CAF_CAT(CAF_PRINT, level)(CAF_CAT(CAF_LVL_NAME, level)(), classname,         \
@@ -24,7 +24,8 @@
 #include <vector>
 #include <memory>
 #include <utility>
-#include <typeinfo>
+#include <cstddef>
+#include <type_traits>
 
 #include "caf/config.hpp"
 #include "caf/ref_counted.hpp"
@@ -32,32 +33,36 @@
 #include "caf/detail/embedded.hpp"
 #include "caf/detail/memory_cache_flag_type.hpp"
 
-namespace caf {
-class mailbox_element;
-} // namespace caf
-
 namespace caf {
 namespace detail {
 
-namespace {
-
-constexpr size_t s_alloc_size = 1024 * 1024;    // allocate ~1mb chunks
-constexpr size_t s_cache_size = 10 * 1024 * 1024; // cache about 10mb per thread
-constexpr size_t s_min_elements = 5;        // don't create < 5 elements
-constexpr size_t s_max_elements = 20;       // don't create > 20 elements
-
-} // namespace <anonymous>
-
 using embedded_storage = std::pair<intrusive_ptr<ref_counted>, void*>;
 
-class memory_cache {
- public:
-  virtual ~memory_cache();
-  virtual embedded_storage new_embedded_storage() = 0;
+/**
+ * Allocation statistics for a type created via `memory::create`.
+ */
+struct memory_stats {
+  /**
+   * Number of instances currently alive in any thread.
+   */
+  size_t live_objects;
+
+  /**
+   * Number of bytes kept in the freelists for the size class of the type.
+   * Types with similar size share their size class and thus this number.
+   */
+  size_t retained_bytes;
 };
 
 template <class T>
-class basic_memory_cache;
+struct memory_embedded {
+  using type =
+    typename std::conditional<
+      T::memory_cache_flag == needs_embedding,
+      embedded<T>,
+      T
+     >::type;
+};
 
 #ifdef CAF_NO_MEM_MANAGEMENT
 
@@ -98,130 +103,59 @@ class memory {
     return unbox_rc_storage(new embedded_t(std::forward<Ts>(xs)...));
   }
 
-  static inline memory_cache* get_cache_map_entry(const std::type_info*) {
-    return nullptr;
+  // Statistics are not available without memory management.
+  template <class T>
+  static memory_stats stats() {
+    return {0, 0};
   }
 };
 
 #else // CAF_NO_MEM_MANAGEMENT
 
-template <class T>
-class basic_memory_cache : public memory_cache {
- public:
-  static constexpr size_t ne = s_alloc_size / sizeof(T);
-  static constexpr size_t ms = ne < s_min_elements ? s_min_elements : ne;
-  static constexpr size_t dsize = ms > s_max_elements ? s_max_elements : ms;
-
-  static_assert(dsize > 0, "dsize == 0");
-
-  using embedded_t =
-    typename std::conditional<
-      T::memory_cache_flag == needs_embedding,
-      embedded<T>,
-      T
-     >::type;
-
-  struct wrapper {
-    union {
-      embedded_t instance;
-    };
-
-    wrapper() {
-      // nop
-    }
-
-    ~wrapper() {
-      // nop
-    }
-  };
-
-  class storage : public ref_counted {
-   public:
-    storage() : m_pos(0) {
-      // nop
-    }
-
-    ~storage() {
-      // nop
-    }
-
-    bool has_next() {
-      return m_pos < dsize;
-    }
-
-    embedded_t* next() {
-      return &(m_data[m_pos++].instance);
-    }
-
-   private:
-    size_t m_pos;
-    wrapper m_data[dsize];
-  };
-
-  embedded_storage new_embedded_storage() override {
-    // allocate cache on-the-fly
-    if (!m_cache) {
-      m_cache.reset(new storage, false); // starts with ref count of 1
-      CAF_ASSERT(m_cache->unique());
-    }
-    auto res = m_cache->next();
-    if (m_cache->has_next()) {
-      return {m_cache, res};
-    }
-    // we got the last element out of the cache; pass the reference to the
-    // client to avoid pointless increase/decrease ops on the reference count
-    embedded_storage result;
-    result.first.reset(m_cache.release(), false);
-    result.second = res;
-    return result;
-  }
-
- private:
-  intrusive_ptr<storage> m_cache;
-};
-
+/**
+ * Allocates objects from thread-local freelists. Each thread owns one cache
+ * with a freelist per size class. Memory released by another thread travels
+ * back to its owner in batches and gets recycled on the owner's next
+ * allocation. Objects exceeding the largest size class bypass the cache.
+ */
 class memory {
-
-  memory() = delete;
-
-  template <class>
-  friend class basic_memory_cache;
-
  public:
+  memory() = delete;
 
   // Allocates storage, initializes a new object, and returns the new instance.
   template <class T, class... Ts>
   static T* create(Ts&&... xs) {
-    using embedded_t =
-      typename std::conditional<
-        T::memory_cache_flag == needs_embedding,
-        embedded<T>,
-        T
-       >::type;
-    auto mc = get_or_set_cache_map_entry<T>();
-    auto es = mc->new_embedded_storage();
+    using embedded_t = typename memory_embedded<T>::type;
+    static_assert(alignof(embedded_t) <= alignof(std::max_align_t),
+                  "memory::create does not support over-aligned types");
+    auto es = allocate(type_id<T>(), sizeof(embedded_t));
     auto ptr = reinterpret_cast<embedded_t*>(es.second);
     new (ptr) embedded_t(std::move(es.first), std::forward<Ts>(xs)...);
     return ptr;
   }
 
-  static memory_cache* get_cache_map_entry(const std::type_info* tinf);
+  /**
+   * Returns allocation statistics for `T`, accumulated over all threads.
+   */
+  template <class T>
+  static memory_stats stats() {
+    return stats(type_id<T>(), sizeof(typename memory_embedded<T>::type));
+  }
 
  private:
-
-  static void add_cache_map_entry(const std::type_info* tinf,
-                                  memory_cache* instance);
-
+  // Returns a process-wide unique ID for `T`. IDs are assigned on first use
+  // and index the per-type counters of each thread-local cache.
   template <class T>
-  static inline memory_cache* get_or_set_cache_map_entry() {
-    auto mc = get_cache_map_entry(&typeid(T));
-    if (!mc) {
-      mc = new basic_memory_cache<T>;
-      add_cache_map_entry(&typeid(T), mc);
-    }
-    return mc;
+  static size_t type_id() {
+    static size_t id = next_type_id();
+    return id;
   }
 
+  static size_t next_type_id();
+
+  static embedded_storage allocate(size_t type_id, size_t num_bytes);
+
+  static memory_stats stats(size_t type_id, size_t num_bytes);
 };
 
 #endif // CAF_NO_MEM_MANAGEMENT
@@ -211,8 +211,9 @@ class advanced_match_case_builder : public message_case_builder {
   advanced_match_case_builder() = default;
 
   template <class... Fs>
-  advanced_match_case_builder(variadic_ctor, Fs... fs)
-      : m_guards(make_guards(Pattern{}, fs...)) {
+  advanced_match_case_builder(variadic_ctor, optional<atom_value> la, Fs... fs)
+      : m_guards(make_guards(Pattern{}, fs...)),
+        m_leading_atom(std::move(la)) {
     // nop
   }
 
@@ -223,7 +224,7 @@ class advanced_match_case_builder : public message_case_builder {
   template <class F>
   typename get_advanced_match_case<F, Projections, Pattern>::type
   operator>>(F f) const {
-    return {f, m_guards};
+    return {f, m_guards, m_leading_atom};
   }
 
  private:
@@ -249,6 +250,7 @@ class advanced_match_case_builder : public message_case_builder {
   }
 
   guards_tuple m_guards;
+  optional<atom_value> m_leading_atom;
 };
 
 template <class Projections, class Pattern>
@@ -266,8 +268,9 @@ struct advanced_match_case_builder<Projections, Pattern, true>
   advanced_match_case_builder() = default;
 
   template <class... Fs>
-  advanced_match_case_builder(variadic_ctor, Fs... fs)
-      : m_guards(make_guards(Pattern{}, fs...)) {
+  advanced_match_case_builder(variadic_ctor, optional<atom_value> la, Fs... fs)
+      : m_guards(make_guards(Pattern{}, fs...)),
+        m_leading_atom(std::move(la)) {
     // nop
   }
 
@@ -293,7 +296,7 @@ struct advanced_match_case_builder<Projections, Pattern, true>
         typename tl_replicate<get_callable_trait<F>::num_args, unit_t>::type,
         std::tuple
       >::type;
-    return {f, std::tuple_cat(m_guards, padding{})};
+    return {f, std::tuple_cat(m_guards, padding{}), m_leading_atom};
   }
 
  private:
@@ -324,6 +327,7 @@ struct advanced_match_case_builder<Projections, Pattern, true>
   }
 
   guards_tuple m_guards;
+  optional<atom_value> m_leading_atom;
 };
 
 template <class Left, class Right>
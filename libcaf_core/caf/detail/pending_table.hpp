@@ -0,0 +1,274 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_PENDING_TABLE_HPP
+#define CAF_DETAIL_PENDING_TABLE_HPP
+
+#include <deque>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+#include "caf/config.hpp"
+#include "caf/message_id.hpp"
+
+namespace caf {
+namespace detail {
+
+/**
+ * A hash table for pending requests keyed by message ID. The table uses
+ * open addressing with linear probing and backward-shift deletion. Entries
+ * live in a slab and never move, i.e., references to an entry remain valid
+ * until it gets erased. Entries form a list from the most recent to the
+ * oldest insertion. Keys do not need to be unique.
+ */
+template <class T>
+class pending_table {
+ public:
+  using value_type = std::pair<message_id, T>;
+
+  pending_table() : m_head(npos), m_size(0) {
+    // nop
+  }
+
+  pending_table(const pending_table&) = delete;
+  pending_table& operator=(const pending_table&) = delete;
+
+  inline bool empty() const {
+    return m_size == 0;
+  }
+
+  inline size_t size() const {
+    return m_size;
+  }
+
+  /**
+   * Returns the most recently inserted entry.
+   * @pre `!empty()`
+   */
+  inline value_type& front() {
+    CAF_ASSERT(!empty());
+    return m_nodes[m_head].value;
+  }
+
+  /**
+   * Inserts `x` as most recent entry.
+   */
+  value_type& push_front(value_type x) {
+    if ((m_size + 1) * 2 > m_slots.size()) {
+      grow();
+    }
+    size_t pos;
+    if (m_free.empty()) {
+      pos = m_nodes.size();
+      m_nodes.emplace_back();
+    } else {
+      pos = m_free.back();
+      m_free.pop_back();
+    }
+    auto& n = m_nodes[pos];
+    n.value = std::move(x);
+    n.prev = npos;
+    n.next = m_head;
+    if (m_head != npos) {
+      m_nodes[m_head].prev = pos;
+    }
+    m_head = pos;
+    insert_slot(pos);
+    ++m_size;
+    return n.value;
+  }
+
+  /**
+   * Returns an entry for `key` or `nullptr`.
+   */
+  value_type* find(message_id key) {
+    return find_if(key, [](const T&) { return true; });
+  }
+
+  const value_type* find(message_id key) const {
+    auto pred = [](const T&) { return true; };
+    auto i = find_slot(key, pred);
+    return i == npos ? nullptr : &m_nodes[m_slots[i] - 1].value;
+  }
+
+  /**
+   * Returns an entry for `key` with a value
+   * satisfying `pred` or `nullptr`.
+   */
+  template <class Predicate>
+  value_type* find_if(message_id key, Predicate pred) {
+    auto i = find_slot(key, pred);
+    return i == npos ? nullptr : &m_nodes[m_slots[i] - 1].value;
+  }
+
+  /**
+   * Removes an entry for `key` and returns whether an entry was found.
+   */
+  bool erase(message_id key) {
+    return erase_if(key, [](const T&) { return true; });
+  }
+
+  /**
+   * Removes an entry for `key` with a value satisfying `pred`
+   * and returns whether an entry was found.
+   */
+  template <class Predicate>
+  bool erase_if(message_id key, Predicate pred) {
+    auto i = find_slot(key, pred);
+    if (i == npos) {
+      return false;
+    }
+    erase_slot(i);
+    return true;
+  }
+
+  /**
+   * Removes all entries satisfying `pred` after passing them to `f`.
+   */
+  template <class Predicate, class F>
+  void remove_if(Predicate pred, F f) {
+    for (size_t i = 0; i < m_slots.size(); ) {
+      if (m_slots[i] != 0) {
+        auto& x = m_nodes[m_slots[i] - 1].value;
+        if (pred(x)) {
+          f(x);
+          // erase_slot shifts another entry into slot `i`
+          erase_slot(i);
+          continue;
+        }
+      }
+      ++i;
+    }
+  }
+
+  void clear() {
+    m_nodes.clear();
+    m_free.clear();
+    m_slots.clear();
+    m_head = npos;
+    m_size = 0;
+  }
+
+ private:
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  static constexpr size_t min_slots = 16;
+
+  struct node {
+    value_type value;
+    size_t prev;
+    size_t next;
+  };
+
+  inline size_t home(message_id key) const {
+    // Fibonacci hashing spreads the sequential request IDs of an actor
+    auto h = key.integer_value() * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(h >> 32) & (m_slots.size() - 1);
+  }
+
+  template <class Predicate>
+  size_t find_slot(message_id key, Predicate& pred) const {
+    if (m_slots.empty()) {
+      return npos;
+    }
+    for (auto i = home(key); m_slots[i] != 0; i = next_slot(i)) {
+      auto& x = m_nodes[m_slots[i] - 1].value;
+      if (x.first == key && pred(x.second)) {
+        return i;
+      }
+    }
+    return npos;
+  }
+
+  inline size_t next_slot(size_t i) const {
+    return (i + 1) & (m_slots.size() - 1);
+  }
+
+  void insert_slot(size_t pos) {
+    auto i = home(m_nodes[pos].value.first);
+    while (m_slots[i] != 0) {
+      i = next_slot(i);
+    }
+    m_slots[i] = pos + 1;
+  }
+
+  void erase_slot(size_t i) {
+    auto pos = m_slots[i] - 1;
+    auto& n = m_nodes[pos];
+    // unlink node
+    if (n.prev != npos) {
+      m_nodes[n.prev].next = n.next;
+    } else {
+      m_head = n.next;
+    }
+    if (n.next != npos) {
+      m_nodes[n.next].prev = n.prev;
+    }
+    n.value = value_type{};
+    m_free.push_back(pos);
+    --m_size;
+    // shift subsequent entries of the probe sequence backwards
+    auto hole = i;
+    for (auto j = next_slot(i); m_slots[j] != 0; j = next_slot(j)) {
+      auto h = home(m_nodes[m_slots[j] - 1].value.first);
+      // move entry in slot `j` unless its home lies cyclically in (hole, j]
+      bool stays = hole <= j ? (hole < h && h <= j) : (hole < h || h <= j);
+      if (!stays) {
+        m_slots[hole] = m_slots[j];
+        hole = j;
+      }
+    }
+    m_slots[hole] = 0;
+  }
+
+  void grow() {
+    std::vector<size_t> slots(m_slots.empty() ? min_slots
+                                              : m_slots.size() * 2, 0);
+    m_slots.swap(slots);
+    for (auto x : slots) {
+      if (x != 0) {
+        insert_slot(x - 1);
+      }
+    }
+  }
+
+  // stable storage for entries
+  std::deque<node> m_nodes;
+  // indexes of unused nodes
+  std::vector<size_t> m_free;
+  // node index + 1 for occupied slots, 0 otherwise
+  std::vector<size_t> m_slots;
+  // most recently inserted node
+  size_t m_head;
+  size_t m_size;
+};
+
+template <class T>
+constexpr size_t pending_table<T>::npos;
+
+template <class T>
+constexpr size_t pending_table<T>::min_slots;
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_PENDING_TABLE_HPP
@@ -84,10 +84,13 @@ class single_reader_queue {
    */
   enqueue_result enqueue(pointer new_element) {
     CAF_ASSERT(new_element != nullptr);
+    // count first to make sure the reader never decrements below zero
+    m_size.fetch_add(1, std::memory_order_relaxed);
     pointer e = m_stack.load();
     for (;;) {
       if (!e) {
         // if tail is nullptr, the queue has been closed
+        m_size.fetch_sub(1, std::memory_order_relaxed);
         m_delete(new_element);
         return enqueue_result::queue_closed;
       }
@@ -101,13 +104,92 @@ class single_reader_queue {
     }
   }
 
+  /**
+   * Tries to enqueue a new element to the high priority lane. The reader
+   * drains this lane before any element enqueued via `enqueue`, i.e.,
+   * high priority elements never need to be sorted by the reader.
+   */
+  enqueue_result enqueue_high(pointer new_element) {
+    CAF_ASSERT(new_element != nullptr);
+    m_size.fetch_add(1, std::memory_order_relaxed);
+    pointer e = m_high_stack.load();
+    for (;;) {
+      if (e == high_closed_dummy()) {
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        m_delete(new_element);
+        return enqueue_result::queue_closed;
+      }
+      new_element->next = e;
+      if (m_high_stack.compare_exchange_strong(e, new_element)) {
+        break;
+      }
+      // continue with new value of e
+    }
+    // the reader blocks on m_stack, which thus also signals the high lane;
+    // try_block() re-checks the high lane to not miss this element
+    e = reader_blocked_dummy();
+    if (m_stack.compare_exchange_strong(e, stack_empty_dummy())) {
+      return enqueue_result::unblocked_reader;
+    }
+    return enqueue_result::success;
+  }
+
+  /**
+   * Tries to enqueue the list of elements starting at `first` with a single
+   * CAS operation. Elements are linked via their `next` pointer in FIFO
+   * order, i.e., `first` is the oldest element. Unlike `enqueue`, this
+   * function does not delete any element if the queue has been closed,
+   * i.e., ownership remains with the caller when returning `queue_closed`.
+   */
+  enqueue_result enqueue_batch(pointer first) {
+    CAF_ASSERT(first != nullptr);
+    // reverse the list, since the stack holds the newest element on top
+    pointer top = nullptr;
+    pointer bottom = first;
+    size_t n = 0;
+    for (auto i = first; i != nullptr; ) {
+      auto next = i->next;
+      i->next = top;
+      top = i;
+      i = next;
+      ++n;
+    }
+    m_size.fetch_add(n, std::memory_order_relaxed);
+    pointer e = m_stack.load();
+    for (;;) {
+      if (!e) {
+        m_size.fetch_sub(n, std::memory_order_relaxed);
+        // restore FIFO order before giving the list back to the caller
+        pointer prev = nullptr;
+        for (auto i = top; i != nullptr; ) {
+          auto next = i->next;
+          i->next = prev;
+          prev = i;
+          i = next;
+        }
+        return enqueue_result::queue_closed;
+      }
+      // a dummy is never part of a non-empty list
+      bottom->next = is_dummy(e) ? nullptr : e;
+      if (m_stack.compare_exchange_strong(e, top)) {
+        return  (e == reader_blocked_dummy()) ? enqueue_result::unblocked_reader
+                                              : enqueue_result::success;
+      }
+      // continue with new value of e
+    }
+  }
+
   /**
    * Queries whether there is new data to read, i.e., whether the next
    * call to {@link try_pop} would succeeed.
    * @pre !closed()
    */
   bool can_fetch_more() {
-    if (m_head != nullptr) {
+    if (m_head != nullptr || m_high_head != nullptr) {
+      return true;
+    }
+    auto high = m_high_stack.load();
+    if (high != nullptr && high != high_closed_dummy()) {
       return true;
     }
     auto ptr = m_stack.load();
@@ -121,7 +203,18 @@ class single_reader_queue {
    */
   bool empty() {
     CAF_ASSERT(!closed());
-    return m_cache.empty() && m_head == nullptr && is_dummy(m_stack.load());
+    return m_cache.empty() && m_head == nullptr && m_high_head == nullptr
+           && m_high_stack.load() == nullptr && is_dummy(m_stack.load());
+  }
+
+  /**
+   * Returns the number of elements that were enqueued but not yet
+   * dequeued via {@link try_pop}. Elements moved to the cache by the
+   * reader are not included. The result is only a snapshot when called
+   * from a writer, since other writers may enqueue concurrently.
+   */
+  size_t size() const {
+    return m_size.load(std::memory_order_relaxed);
   }
 
   /**
@@ -146,6 +239,11 @@ class single_reader_queue {
     auto e = stack_empty_dummy();
     bool res = m_stack.compare_exchange_strong(e, reader_blocked_dummy());
     CAF_ASSERT(e != nullptr);
+    if (res && m_high_stack.load() != nullptr) {
+      // a writer enqueued to the high priority lane concurrently and
+      // either sees our blocked state and wakes us up or we revert it
+      return !try_unblock();
+    }
     // return true in case queue was already blocked
     return res || e == reader_blocked_dummy();
   }
@@ -178,10 +276,19 @@ class single_reader_queue {
     if (fetch_new_data(nullptr)) {
       clear_cached_elements(f);
     }
+    // close the high priority lane after m_stack, since writers of the
+    // high priority lane never check m_stack for closing the queue
+    if (fetch_high_data(high_closed_dummy())) {
+      clear_cached_elements(f);
+    }
     m_cache.clear(std::move(f));
   }
 
-  single_reader_queue() : m_head(nullptr) {
+  single_reader_queue()
+      : m_high_stack(nullptr),
+        m_size(0),
+        m_head(nullptr),
+        m_high_head(nullptr) {
     m_stack = stack_empty_dummy();
   }
 
@@ -197,18 +304,20 @@ class single_reader_queue {
       return res;
     }
     fetch_new_data();
-    auto ptr = m_head;
-    while (ptr && res < max_count) {
-      ptr = ptr->next;
-      ++res;
+    fetch_high_data();
+    for (auto ptr : {m_high_head, m_head}) {
+      while (ptr && res < max_count) {
+        ptr = ptr->next;
+        ++res;
+      }
     }
     return res;
   }
 
   // note: the cache is intended to be used by the owner, the queue itself
   //       never accesses the cache other than for counting;
-  //       the first partition of the cache is meant to be used to store and
-  //       sort messages that were not processed yet, while the second
+  //       the first partition of the cache is meant to be used to store
+  //       messages that were not processed yet, while the second
   //       partition is meant to store skipped messages
   cache_type& cache() {
     return m_cache;
@@ -220,7 +329,18 @@ class single_reader_queue {
 
   template <class Mutex, class CondVar>
   bool synchronized_enqueue(Mutex& mtx, CondVar& cv, pointer new_element) {
-    switch (enqueue(new_element)) {
+    return synchronized_notify(mtx, cv, enqueue(new_element));
+  }
+
+  template <class Mutex, class CondVar>
+  bool synchronized_enqueue_high(Mutex& mtx, CondVar& cv,
+                                 pointer new_element) {
+    return synchronized_notify(mtx, cv, enqueue_high(new_element));
+  }
+
+  template <class Mutex, class CondVar>
+  bool synchronized_notify(Mutex& mtx, CondVar& cv, enqueue_result res) {
+    switch (res) {
       case enqueue_result::unblocked_reader: {
         std::unique_lock<Mutex> guard(mtx);
         cv.notify_one();
@@ -237,6 +357,17 @@ class single_reader_queue {
     CAF_CRITICAL("invalid result of enqueue()");
   }
 
+  template <class Mutex, class CondVar>
+  enqueue_result synchronized_enqueue_batch(Mutex& mtx, CondVar& cv,
+                                            pointer first) {
+    auto res = enqueue_batch(first);
+    if (res == enqueue_result::unblocked_reader) {
+      std::unique_lock<Mutex> guard(mtx);
+      cv.notify_one();
+    }
+    return res;
+  }
+
   template <class Mutex, class CondVar>
   void synchronized_await(Mutex& mtx, CondVar& cv) {
     CAF_ASSERT(!closed());
@@ -267,9 +398,12 @@ class single_reader_queue {
  private:
   // exposed to "outside" access
   std::atomic<pointer> m_stack;
+  std::atomic<pointer> m_high_stack;
+  std::atomic<size_t> m_size;
 
   // accessed only by the owner
   pointer m_head;
+  pointer m_high_head;
   deleter_type m_delete;
   intrusive_partitioned_list<value_type, deleter_type> m_cache;
 
@@ -277,8 +411,10 @@ class single_reader_queue {
   bool fetch_new_data(pointer end_ptr) {
     CAF_ASSERT(end_ptr == nullptr || end_ptr == stack_empty_dummy());
     pointer e = m_stack.load();
-    // must not be called on a closed queue
-    CAF_ASSERT(e != nullptr);
+    if (e == nullptr) {
+      // a closed queue never receives new data
+      return false;
+    }
     // fetching data while blocked is an error
     CAF_ASSERT(e != reader_blocked_dummy());
     // it's enough to check this once, since only the owner is allowed
@@ -311,10 +447,52 @@ class single_reader_queue {
     return fetch_new_data(stack_empty_dummy());
   }
 
+  // atomically sets m_high_stack to `end_ptr` and appends all elements
+  // of the high priority lane to m_high_head
+  bool fetch_high_data(pointer end_ptr) {
+    auto e = m_high_stack.exchange(end_ptr);
+    CAF_ASSERT(e != high_closed_dummy());
+    if (!e) {
+      return false;
+    }
+    pointer first = nullptr;
+    while (e) {
+      auto next = e->next;
+      e->next = first;
+      first = e;
+      e = next;
+    }
+    if (!m_high_head) {
+      m_high_head = first;
+    } else {
+      auto last = m_high_head;
+      while (last->next) {
+        last = last->next;
+      }
+      last->next = first;
+    }
+    return true;
+  }
+
+  bool fetch_high_data() {
+    // avoid the write access if the high priority lane is empty and
+    // never re-open the lane after close() replaced it with a dummy
+    auto e = m_high_stack.load();
+    return e != nullptr && e != high_closed_dummy()
+           && fetch_high_data(nullptr);
+  }
+
   pointer take_head() {
+    if (m_high_head != nullptr || fetch_high_data()) {
+      auto result = m_high_head;
+      m_high_head = m_high_head->next;
+      m_size.fetch_sub(1, std::memory_order_relaxed);
+      return result;
+    }
     if (m_head != nullptr || fetch_new_data()) {
       auto result = m_head;
       m_head = m_head->next;
+      m_size.fetch_sub(1, std::memory_order_relaxed);
       return result;
     }
     return nullptr;
@@ -322,10 +500,18 @@ class single_reader_queue {
 
   template <class F>
   void clear_cached_elements(const F& f) {
+    while (m_high_head) {
+      auto next = m_high_head->next;
+      f(*m_high_head);
+      m_delete(m_high_head);
+      m_size.fetch_sub(1, std::memory_order_relaxed);
+      m_high_head = next;
+    }
     while (m_head) {
       auto next = m_head->next;
       f(*m_head);
       m_delete(m_head);
+      m_size.fetch_sub(1, std::memory_order_relaxed);
       m_head = next;
     }
   }
@@ -342,6 +528,12 @@ class single_reader_queue {
                                      + static_cast<intptr_t>(sizeof(void*)));
   }
 
+  pointer high_closed_dummy() {
+    // we are not going to dereference this pointer either
+    return reinterpret_cast<pointer>(reinterpret_cast<intptr_t>(this)
+                                     + static_cast<intptr_t>(2 * sizeof(void*)));
+  }
+
   bool is_dummy(pointer ptr) {
     return ptr == stack_empty_dummy() || ptr == reader_blocked_dummy();
   }
@@ -70,6 +70,8 @@ class singletons {
   // returns false if singleton is already defined
   static bool set_scheduling_coordinator(scheduler::abstract_coordinator*);
 
+  static scheduler::thread_pool* get_blocking_pool();
+
   static group_manager* get_group_manager();
 
   static actor_registry* get_actor_registry();
@@ -0,0 +1,127 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_STASH_INDEX_HPP
+#define CAF_DETAIL_STASH_INDEX_HPP
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "caf/behavior.hpp"
+#include "caf/message_id.hpp"
+#include "caf/mailbox_element.hpp"
+
+namespace caf {
+namespace detail {
+
+/**
+ * Keeps track of the skipped messages of an actor, i.e., of the second
+ * partition of its cache, by counting stashed messages per type token and
+ * per response ID. An actor re-invokes its stash only after its behavior,
+ * the awaited response ID, or its exit trapping changed, or after a stashed
+ * message left the stash, and then only for messages the current state can
+ * possibly handle. Hence, handlers that skip messages depending on other
+ * state of the actor must change the behavior to receive them later.
+ */
+class stash_index {
+ public:
+  /**
+   * Filters the stash for one pass of re-invoking skipped messages and
+   * keeps the index up to date while messages leave and re-enter the stash.
+   */
+  class scan {
+   public:
+    scan(stash_index& parent, const behavior& bhvr, message_id awaited_id,
+         bool trap_exit);
+
+    /**
+     * Returns whether any stashed message might match. Returns `false`
+     * without looking at the index if the stash was already checked
+     * in the same state.
+     */
+    bool needed() const;
+
+    /**
+     * Stores that no stashed message matched in this state.
+     */
+    void completed();
+
+    // observer interface for intrusive_partitioned_list::invoke
+
+    bool accepts(const mailbox_element& x) const;
+
+    inline void taken(const mailbox_element& x) {
+      m_parent.remove(x);
+    }
+
+    inline void restored(const mailbox_element& x) {
+      m_parent.add(x);
+    }
+
+   private:
+    bool may_match(uint32_t type_token) const;
+
+    bool same_state() const;
+
+    stash_index& m_parent;
+    behavior::impl_ptr m_bhvr;
+    message_id m_awaited_id;
+    bool m_trap_exit;
+  };
+
+  stash_index();
+
+  /**
+   * Adds `x` to the index after it entered the stash.
+   */
+  void add(const mailbox_element& x);
+
+  /**
+   * Removes `x` from the index before it leaves the stash.
+   */
+  void remove(const mailbox_element& x);
+
+  /**
+   * Removes all entries, e.g., after discarding the stash.
+   */
+  void clear();
+
+  inline size_t size() const {
+    return m_size;
+  }
+
+ private:
+  // number of stashed ordinary messages per type token
+  std::unordered_map<uint32_t, size_t> m_tokens;
+  // number of stashed responses per response ID
+  std::unordered_map<uint64_t, size_t> m_responses;
+  size_t m_size;
+  // number of stashed exit messages, which were skipped while trapping exits
+  size_t m_exit_msgs;
+  // the state of the last scan that did not find a match
+  behavior::impl_ptr m_checked_bhvr;
+  message_id m_checked_awaited_id;
+  bool m_checked_trap_exit;
+  bool m_checked;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_STASH_INDEX_HPP
@@ -0,0 +1,201 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_TIMER_WHEEL_HPP
+#define CAF_DETAIL_TIMER_WHEEL_HPP
+
+#include <array>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+
+namespace caf {
+namespace detail {
+
+/**
+ * A hierarchical timing wheel with O(1) insertion and removal of timers.
+ * The wheel consists of `num_levels` levels with `slots_per_level` slots
+ * each. Timers on level 0 expire at the tick of their slot, timers on higher
+ * levels are cascaded down one level whenever the wheel passes their slot.
+ * Time is measured in abstract ticks and only advances by calling `advance`.
+ * This class is not thread-safe and does not own its nodes.
+ */
+class timer_wheel {
+ public:
+  static constexpr size_t bits_per_level = 6;
+
+  static constexpr size_t slots_per_level = size_t{1} << bits_per_level;
+
+  static constexpr size_t num_levels = 6;
+
+  /**
+   * Denotes "no pending timer" in `next_event`.
+   */
+  static constexpr uint64_t infinite = std::numeric_limits<uint64_t>::max();
+
+  /**
+   * An intrusive list node for storing timers in the wheel.
+   */
+  class node {
+   public:
+    friend class timer_wheel;
+
+    node() : m_prev(nullptr), m_next(nullptr), m_deadline(0), m_level(-1) {
+      // nop
+    }
+
+    node(const node&) = delete;
+    node& operator=(const node&) = delete;
+
+    inline uint64_t deadline() const {
+      return m_deadline;
+    }
+
+    /**
+     * Sets the tick at which this timer expires.
+     * @pre `!linked()`
+     */
+    inline void deadline(uint64_t tick) {
+      m_deadline = tick;
+    }
+
+    inline bool linked() const {
+      return m_level >= 0;
+    }
+
+   private:
+    node* m_prev;
+    node* m_next;
+    uint64_t m_deadline;
+    int16_t m_level;
+    uint16_t m_slot;
+  };
+
+  explicit timer_wheel(uint64_t start_tick = 0);
+
+  timer_wheel(const timer_wheel&) = delete;
+  timer_wheel& operator=(const timer_wheel&) = delete;
+
+  /**
+   * Inserts `ptr` into the wheel. Timers with a deadline in the
+   * past expire on the next tick.
+   * @pre `!ptr->linked()`
+   */
+  void insert(node* ptr);
+
+  /**
+   * Removes `ptr` from the wheel without calling any handler.
+   * @pre `ptr->linked()`
+   */
+  void erase(node* ptr);
+
+  /**
+   * Returns the tick at which the wheel needs to be advanced next, i.e.,
+   * the earliest tick at which either a timer expires or timers cascade
+   * down a level, or `infinite` if the wheel is empty.
+   */
+  uint64_t next_event() const;
+
+  /**
+   * Advances the wheel to `tick` and calls `f(ptr)` for each expired timer
+   * after removing it from the wheel. `f` must not modify the wheel.
+   */
+  template <class F>
+  void advance(uint64_t tick, F f) {
+    while (m_now < tick) {
+      auto next = next_event();
+      if (next > tick) {
+        m_now = tick;
+        return;
+      }
+      m_now = next;
+      cascade();
+      auto& head = m_slots[0][m_now & slot_mask];
+      while (head.m_next != &head) {
+        auto ptr = head.m_next;
+        erase(ptr);
+        f(ptr);
+      }
+    }
+  }
+
+  /**
+   * Removes all timers from the wheel and calls `f(ptr)` for each one.
+   */
+  template <class F>
+  void clear(F f) {
+    for (auto& level : m_slots) {
+      for (auto& head : level) {
+        while (head.m_next != &head) {
+          auto ptr = head.m_next;
+          erase(ptr);
+          f(ptr);
+        }
+      }
+    }
+  }
+
+  /**
+   * Returns the current tick of the wheel.
+   */
+  inline uint64_t now() const {
+    return m_now;
+  }
+
+  /**
+   * Returns the number of pending timers.
+   */
+  inline size_t size() const {
+    return m_size;
+  }
+
+  inline bool empty() const {
+    return m_size == 0;
+  }
+
+ private:
+  static constexpr uint64_t slot_mask = slots_per_level - 1;
+
+  // moves all timers from the current slot on each level > 0
+  // for which `m_now` is a slot boundary to a lower level
+  void cascade();
+
+  // links `ptr` into the slot matching its deadline
+  void relink(node* ptr);
+
+  // links `ptr` into given slot
+  void link(node* ptr, size_t level, size_t slot);
+
+  // unlinks `ptr` from its slot
+  void unlink(node* ptr);
+
+  // current time of the wheel
+  uint64_t m_now;
+  // number of pending timers
+  size_t m_size;
+  // one bit for each non-empty slot per level
+  std::array<uint64_t, num_levels> m_occupied;
+  // sentinel nodes of the circular slot lists
+  std::array<std::array<node, slots_per_level>, num_levels> m_slots;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_TIMER_WHEEL_HPP
@@ -144,6 +144,18 @@ struct is_primitive {
                                 || std::is_convertible<T, atom_value>::value;
 };
 
+/**
+ * Checks whether `T` is an integer type with a binary representation
+ * equal to one of the fixed-size integer types, i.e., excluding `bool`.
+ */
+template <class T>
+struct is_raw_integer {
+  static constexpr bool value = std::is_integral<T>::value
+                                && !std::is_same<T, bool>::value
+                                && (sizeof(T) == 1 || sizeof(T) == 2
+                                    || sizeof(T) == 4 || sizeof(T) == 8);
+};
+
 /**
  * Chekcs wheter `T1` is comparable with `T2`.
  */
@@ -0,0 +1,213 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_WORK_STEALING_DEQUE_HPP
+#define CAF_DETAIL_WORK_STEALING_DEQUE_HPP
+
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "caf/config.hpp"
+
+#include "caf/detail/double_ended_queue.hpp" // CAF_CACHE_LINE_SIZE
+
+namespace caf {
+namespace detail {
+
+/*
+ * A lock-free, growable work-stealing deque based on the algorithm by
+ * Chase and Lev [1] with the memory orderings given by Le et al. [2].
+ * Only the owning thread is allowed to call `push_bottom` and `pop_bottom`,
+ * while any number of threads can call `steal` concurrently. The owner
+ * operates in LIFO order, whereas thieves take the oldest element.
+ *
+ * [1] http://dl.acm.org/citation.cfm?id=1073974
+ * [2] http://dl.acm.org/citation.cfm?id=2442524
+ */
+template <class T>
+class work_stealing_deque {
+ public:
+  using value_type = T;
+  using pointer = value_type*;
+  using size_type = size_t;
+
+  static constexpr size_type default_capacity = 64;
+
+  work_stealing_deque(size_type initial_capacity = default_capacity)
+      : m_top(0),
+        m_bottom(0) {
+    // round up to the next power of two
+    size_type cap = 2;
+    while (cap < initial_capacity) {
+      cap <<= 1;
+    }
+    m_arrays.emplace_back(new circular_array(cap));
+    m_array = m_arrays.back().get();
+  }
+
+  work_stealing_deque(const work_stealing_deque&) = delete;
+  work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+  /**
+   * Pushes `value` to the bottom of the deque, growing the underlying
+   * storage if needed. Must only be called by the owner.
+   */
+  void push_bottom(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto b = m_bottom.load(std::memory_order_relaxed);
+    auto t = m_top.load(std::memory_order_acquire);
+    auto a = m_array.load(std::memory_order_relaxed);
+    if (b - t > static_cast<int64_t>(a->capacity()) - 1) {
+      a = grow(a, b, t);
+    }
+    a->put(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Removes the most recently pushed element or returns `nullptr`
+   * if the deque is empty. Must only be called by the owner.
+   */
+  pointer pop_bottom() {
+    auto b = m_bottom.load(std::memory_order_relaxed) - 1;
+    auto a = m_array.load(std::memory_order_relaxed);
+    m_bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = m_top.load(std::memory_order_relaxed);
+    if (t > b) {
+      // deque is empty, restore bottom
+      m_bottom.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto result = a->get(b);
+    if (t == b) {
+      // last element, race against thieves
+      if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+        result = nullptr;
+      }
+      m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  /**
+   * Removes the oldest element or returns `nullptr` if the deque is empty
+   * or another thread won the race for the same element. Safe to call
+   * from any thread.
+   */
+  pointer steal() {
+    auto t = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto b = m_bottom.load(std::memory_order_acquire);
+    if (t >= b) {
+      return nullptr;
+    }
+    auto a = m_array.load(std::memory_order_acquire);
+    auto result = a->get(t);
+    if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return result;
+  }
+
+  /**
+   * Returns the number of elements in the deque. The result is only
+   * an approximation when called while other threads modify the deque.
+   */
+  size_type size() const {
+    auto b = m_bottom.load(std::memory_order_relaxed);
+    auto t = m_top.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_type>(b - t) : 0;
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  /**
+   * Returns the current capacity of the deque. Must only be called
+   * by the owner.
+   */
+  size_type capacity() const {
+    return m_array.load(std::memory_order_relaxed)->capacity();
+  }
+
+ private:
+  class circular_array {
+   public:
+    circular_array(size_type cap)
+        : m_mask(cap - 1),
+          m_data(new std::atomic<pointer>[cap]) {
+      // nop
+    }
+
+    size_type capacity() const {
+      return m_mask + 1;
+    }
+
+    pointer get(int64_t pos) const {
+      return m_data[static_cast<size_type>(pos) & m_mask]
+             .load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t pos, pointer value) {
+      m_data[static_cast<size_type>(pos) & m_mask]
+      .store(value, std::memory_order_relaxed);
+    }
+
+   private:
+    size_type m_mask;
+    std::unique_ptr<std::atomic<pointer>[]> m_data;
+  };
+
+  // precondition: called by the owner only
+  circular_array* grow(circular_array* old, int64_t b, int64_t t) {
+    auto ptr = new circular_array(old->capacity() * 2);
+    for (auto i = t; i != b; ++i) {
+      ptr->put(i, old->get(i));
+    }
+    // thieves may still read from the old array, hence we cannot
+    // release it until the deque itself gets destroyed
+    m_arrays.emplace_back(ptr);
+    m_array.store(ptr, std::memory_order_release);
+    return ptr;
+  }
+
+  // read by all threads, modified by thieves and the owner
+  std::atomic<int64_t> m_top;
+  char m_pad1[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<int64_t>)];
+  // read by all threads, modified by the owner only
+  std::atomic<int64_t> m_bottom;
+  char m_pad2[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<int64_t>)];
+  // points to the most recent element of m_arrays
+  std::atomic<circular_array*> m_array;
+  // owns all arrays ever allocated by this deque (guarded by the owner)
+  std::vector<std::unique_ptr<circular_array>> m_arrays;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_WORK_STEALING_DEQUE_HPP
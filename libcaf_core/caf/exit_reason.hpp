@@ -61,6 +61,12 @@ static constexpr uint32_t unknown = 0x00006;
  */
 static constexpr uint32_t out_of_workers = 0x00007;
 
+/**
+ * Indicates that a synchronous request was rejected because the
+ * bounded mailbox of the receiver was full.
+ */
+static constexpr uint32_t mailbox_full = 0x00008;
+
 /**
  * Indicates that the actor was forced to shutdown by a user-generated event.
  */
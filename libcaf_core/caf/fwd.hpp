@@ -46,6 +46,7 @@ class message_id;
 class local_actor;
 class actor_proxy;
 class scoped_actor;
+class mailbox_batch;
 class execution_unit;
 class abstract_actor;
 class abstract_group;
@@ -92,6 +93,7 @@ namespace io {
 namespace scheduler {
   class abstract_worker;
   class abstract_coordinator;
+  class thread_pool;
 } // namespace scheduler
 
 namespace detail {
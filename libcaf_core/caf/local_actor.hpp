@@ -24,7 +24,6 @@
 #include <cstdint>
 #include <exception>
 #include <functional>
-#include <forward_list>
 
 #include "caf/fwd.hpp"
 
@@ -52,11 +51,15 @@
 
 #include "caf/detail/logging.hpp"
 #include "caf/detail/disposer.hpp"
+#include "caf/detail/stash_index.hpp"
+#include "caf/detail/pending_table.hpp"
 #include "caf/detail/behavior_stack.hpp"
 #include "caf/detail/typed_actor_util.hpp"
 #include "caf/detail/single_reader_queue.hpp"
 #include "caf/detail/memory_cache_flag_type.hpp"
 
+#include "caf/scheduler/timer_service.hpp"
+
 namespace caf {
 
 /**
@@ -108,6 +111,20 @@ class local_actor : public abstract_actor, public resumable {
     return eval_opts(Os, std::move(res));
   }
 
+  template <class T, spawn_options Os = no_spawn_options, class... Ts>
+  actor spawn_bounded(const mailbox_bounds& bounds, Ts&&... xs) {
+    constexpr auto os = make_unbound(Os);
+    auto res = spawn_class<T, os>(host(), bounds, std::forward<Ts>(xs)...);
+    return eval_opts(Os, std::move(res));
+  }
+
+  template <spawn_options Os = no_spawn_options, class... Ts>
+  actor spawn_bounded(const mailbox_bounds& bounds, Ts&&... xs) {
+    constexpr auto os = make_unbound(Os);
+    auto res = spawn_functor<os>(host(), bounds, std::forward<Ts>(xs)...);
+    return eval_opts(Os, std::move(res));
+  }
+
   /****************************************************************************
    *                            spawn typed actors                            *
    ****************************************************************************/
@@ -208,7 +225,7 @@ class local_actor : public abstract_actor, public resumable {
   void delayed_send(message_priority mp, const channel& dest,
                     const duration& rtime, Ts&&... xs) {
     delayed_send_impl(message_id::make(mp), dest, rtime,
-                      make_message(std::forward<Ts>(xs)...));
+                      std::forward<Ts>(xs)...);
   }
 
   /**
@@ -217,7 +234,7 @@ class local_actor : public abstract_actor, public resumable {
   template <class... Ts>
   void delayed_send(const channel& dest, const duration& rtime, Ts&&... xs) {
     delayed_send_impl(message_id::make(), dest, rtime,
-                      make_message(std::forward<Ts>(xs)...));
+                      std::forward<Ts>(xs)...);
   }
 
   /**
@@ -234,7 +251,7 @@ class local_actor : public abstract_actor, public resumable {
     token tk;
     check_typed_input(dest, tk);
     delayed_send_impl(message_id::make(mp), actor_cast<abstract_channel*>(dest),
-                      rtime, make_message(std::forward<Ts>(xs)...));
+                      rtime, std::forward<Ts>(xs)...);
   }
 
 
@@ -252,7 +269,7 @@ class local_actor : public abstract_actor, public resumable {
     token tk;
     check_typed_input(dest, tk);
     delayed_send_impl(message_id::make(), actor_cast<abstract_channel*>(dest),
-                      rtime, make_message(std::forward<Ts>(xs)...));
+                      rtime, std::forward<Ts>(xs)...);
   }
 
   /****************************************************************************
@@ -305,6 +322,25 @@ class local_actor : public abstract_actor, public resumable {
     set_flag(value, trap_exit_flag);
   }
 
+  /**
+   * Limits the number of messages waiting in the mailbox to `capacity`
+   * and selects how to handle messages that arrive while the mailbox
+   * is full. A capacity of 0 disables the bound.
+   * @warning Call only before this actor is launched, e.g., from
+   *          the constructor or via {@link mailbox_bounds}.
+   */
+  inline void bound_mailbox(size_t capacity, mailbox_overflow policy) {
+    m_mailbox_capacity = capacity;
+    m_mailbox_overflow = policy;
+  }
+
+  /**
+   * Returns the capacity of the mailbox or 0 if it is unbounded.
+   */
+  inline size_t mailbox_capacity() const {
+    return m_mailbox_capacity;
+  }
+
   /**
    * Returns the currently processed message.
    * @warning Only set during callback invocation. Calling this member function
@@ -567,6 +603,9 @@ class local_actor : public abstract_actor, public resumable {
 
   void reset_timeout(uint32_t timeout_id);
 
+  // removes a pending timeout message from the timer service
+  void cancel_timeout();
+
   // @pre has_timeout()
   bool is_active_timeout(uint32_t tid) const;
 
@@ -604,6 +643,8 @@ class local_actor : public abstract_actor, public resumable {
 
   void enqueue(mailbox_element_ptr, execution_unit*) override;
 
+  void enqueue_batch(mailbox_batch, execution_unit*) override;
+
   mailbox_element_ptr next_message();
 
   bool has_next_message();
@@ -614,9 +655,19 @@ class local_actor : public abstract_actor, public resumable {
 
   bool invoke_from_cache(behavior&, message_id);
 
+  // returns whether `x` must be discarded according to the mailbox bounds
+  bool exceeds_mailbox_bounds(const mailbox_element& x) const;
+
+  // discards `x` according to the overflow policy, `eu` is the execution
+  // unit of the calling thread and thus not necessarily our `host()`
+  void drop_message(mailbox_element_ptr x, execution_unit* eu);
+
  protected:
   void do_become(behavior bhvr, bool discard_old);
 
+  // like `do_become`, but does not take ownership of `bhvr`
+  void do_become_ref(behavior& bhvr, bool discard_old);
+
   // used only in thread-mapped actors
   void await_data();
 
@@ -624,7 +675,7 @@ class local_actor : public abstract_actor, public resumable {
   message_id m_last_request_id;
 
   // identifies all IDs of sync messages waiting for a response
-  std::forward_list<pending_response> m_pending_responses;
+  detail::pending_table<behavior> m_pending_responses;
 
   // points to m_dummy_node if no callback is currently invoked,
   // points to the node under processing otherwise
@@ -636,12 +687,24 @@ class local_actor : public abstract_actor, public resumable {
   // identifies the timeout messages we are currently waiting for
   uint32_t m_timeout_id;
 
+  // allows canceling the pending timeout message
+  scheduler::timer_service::handle m_timeout_handle;
+
   // used by both event-based and blocking actors
   detail::behavior_stack m_bhvr_stack;
 
   // used by both event-based and blocking actors
   mailbox_type m_mailbox;
 
+  // indexes skipped messages, i.e., the second partition of the cache
+  detail::stash_index m_stash;
+
+  // maximum number of waiting messages, 0 means unbounded
+  size_t m_mailbox_capacity;
+
+  // selects how to handle messages exceeding m_mailbox_capacity
+  mailbox_overflow m_mailbox_overflow;
+
   /** @endcond */
 
  private:
@@ -663,7 +726,22 @@ class local_actor : public abstract_actor, public resumable {
   void send_impl(message_id mp, abstract_channel* dest, message what);
 
   void delayed_send_impl(message_id mid, const channel& whom,
-                         const duration& rtime, message data);
+                         const duration& rtime, message data = message{});
+
+  template <class T, class... Ts>
+  typename std::enable_if<
+    !std::is_same<typename std::decay<T>::type, message>::value
+  >::type
+  delayed_send_impl(message_id mid, const channel& whom,
+                    const duration& rtime, T&& x, Ts&&... xs) {
+    delayed_send_impl(whom, rtime,
+                      mailbox_element::make_joint(address(), mid,
+                                                  std::forward<T>(x),
+                                                  std::forward<Ts>(xs)...));
+  }
+
+  void delayed_send_impl(const channel& whom, const duration& rtime,
+                         mailbox_element_ptr what);
 
   std::function<void()> m_sync_failure_handler;
   std::function<void()> m_sync_timeout_handler;
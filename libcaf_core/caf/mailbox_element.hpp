@@ -21,6 +21,7 @@
 #define CAF_MAILBOX_ELEMENT_HPP
 
 #include <cstddef>
+#include <utility>
 
 #include "caf/extend.hpp"
 #include "caf/message.hpp"
@@ -87,6 +88,119 @@ class mailbox_element : public memory_managed {
 
 using mailbox_element_ptr = std::unique_ptr<mailbox_element, detail::disposer>;
 
+/**
+ * An owning, FIFO-ordered chain of mailbox elements that are linked via
+ * their `next` pointer. A batch allows enqueueing many messages to the
+ * same receiver using a single atomic operation on its mailbox.
+ */
+class mailbox_batch {
+ public:
+  mailbox_batch() : m_head(nullptr), m_tail(nullptr), m_size(0) {
+    // nop
+  }
+
+  mailbox_batch(mailbox_batch&& other)
+      : m_head(other.m_head),
+        m_tail(other.m_tail),
+        m_size(other.m_size) {
+    other.m_head = nullptr;
+    other.m_tail = nullptr;
+    other.m_size = 0;
+  }
+
+  mailbox_batch& operator=(mailbox_batch&& other) {
+    clear();
+    std::swap(m_head, other.m_head);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_size, other.m_size);
+    return *this;
+  }
+
+  mailbox_batch(const mailbox_batch&) = delete;
+  mailbox_batch& operator=(const mailbox_batch&) = delete;
+
+  ~mailbox_batch() {
+    clear();
+  }
+
+  /**
+   * Appends `ptr` to the end of the batch.
+   */
+  void push_back(mailbox_element_ptr ptr) {
+    auto raw = ptr.release();
+    raw->next = nullptr;
+    if (m_tail) {
+      m_tail->next = raw;
+    } else {
+      m_head = raw;
+    }
+    m_tail = raw;
+    ++m_size;
+  }
+
+  /**
+   * Removes the first element from the batch.
+   * @pre `!empty()`
+   */
+  mailbox_element_ptr pop_front() {
+    auto result = m_head;
+    m_head = m_head->next;
+    if (!m_head) {
+      m_tail = nullptr;
+    }
+    --m_size;
+    result->next = nullptr;
+    return mailbox_element_ptr{result};
+  }
+
+  /**
+   * Returns the first element and transfers ownership
+   * of all elements to the caller.
+   */
+  mailbox_element* release() {
+    auto result = m_head;
+    m_head = nullptr;
+    m_tail = nullptr;
+    m_size = 0;
+    return result;
+  }
+
+  /**
+   * Takes ownership of the chain starting at `first`.
+   */
+  void reset(mailbox_element* first) {
+    clear();
+    for (auto i = first; i != nullptr; ) {
+      auto next = i->next;
+      push_back(mailbox_element_ptr{i});
+      i = next;
+    }
+  }
+
+  void clear() {
+    while (m_head) {
+      pop_front();
+    }
+  }
+
+  inline bool empty() const {
+    return m_head == nullptr;
+  }
+
+  inline size_t size() const {
+    return m_size;
+  }
+
+  inline mailbox_element* front() const {
+    return m_head;
+  }
+
+ private:
+  mailbox_element* m_head;
+  mailbox_element* m_tail;
+  size_t m_size;
+};
+
 } // namespace caf
 
 #endif // CAF_MAILBOX_ELEMENT_HPP
@@ -20,6 +20,7 @@
 #ifndef CAF_MATCH_CASE_HPP
 #define CAF_MATCH_CASE_HPP
 
+#include "caf/atom.hpp"
 #include "caf/none.hpp"
 #include "caf/optional.hpp"
 
@@ -46,7 +47,8 @@ class match_case {
     match
   };
 
-  match_case(bool has_wildcard, uint32_t token);
+  match_case(bool has_wildcard, uint32_t token,
+             optional<atom_value> leading_atom = none);
 
   match_case(match_case&&) = default;
   match_case(const match_case&) = default;
@@ -63,9 +65,35 @@ class match_case {
     return m_has_wildcard;
   }
 
+  /**
+   * Returns the atom this case requires as first element
+   * of a message if known at construction time.
+   */
+  inline const optional<atom_value>& leading_atom() const {
+    return m_leading_atom;
+  }
+
  private:
   bool m_has_wildcard;
   uint32_t m_token;
+  optional<atom_value> m_leading_atom;
+};
+
+/**
+ * Returns the atom constant at the front of `Pattern` if present.
+ */
+template <class Pattern>
+struct leading_atom_constant {
+  static optional<atom_value> get() {
+    return none;
+  }
+};
+
+template <atom_value V, class... Ts>
+struct leading_atom_constant<detail::type_list<atom_constant<V>, Ts...>> {
+  static optional<atom_value> get() {
+    return V;
+  }
 };
 
 struct match_case_zipper {
@@ -184,7 +212,8 @@ class trivial_match_case : public match_case {
     >::type;
 
   trivial_match_case(F f)
-      : match_case(false, detail::make_type_token_from_list<pattern>()),
+      : match_case(false, detail::make_type_token_from_list<pattern>(),
+                   leading_atom_constant<pattern>::get()),
         m_fun(std::move(f)) {
     // nop
   }
@@ -258,8 +287,8 @@ class advanced_match_case : public match_case {
 
   using result_type = typename detail::get_callable_trait<F>::result_type;
 
-  advanced_match_case(bool hw, uint32_t tt, F f)
-      : match_case(hw, tt),
+  advanced_match_case(bool hw, uint32_t tt, optional<atom_value> la, F f)
+      : match_case(hw, tt, std::move(la)),
         m_fun(std::move(f)) {
     // nop
   }
@@ -424,12 +453,23 @@ class advanced_match_case_impl : public
 
   advanced_match_case_impl(F f)
       : super(pattern_has_wildcard<Pattern>::value, static_type_token,
-              std::move(f)) {
+              leading_atom_constant<Pattern>::get(), std::move(f)) {
     // nop
   }
 
   advanced_match_case_impl(F f, projections ps)
       : super(pattern_has_wildcard<Pattern>::value, static_type_token,
+              leading_atom_constant<Pattern>::get(), std::move(f)),
+        m_ps(std::move(ps)) {
+    // nop
+  }
+
+  // `leading_atom` must be the value the first guard in `ps` compares to
+  advanced_match_case_impl(F f, projections ps,
+                           optional<atom_value> leading_atom)
+      : super(pattern_has_wildcard<Pattern>::value, static_type_token,
+              leading_atom ? leading_atom
+                           : leading_atom_constant<Pattern>::get(),
               std::move(f)),
         m_ps(std::move(ps)) {
     // nop
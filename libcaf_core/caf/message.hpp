@@ -131,6 +131,12 @@ class message {
    */
   const char* uniform_name_at(size_t p) const;
 
+  /**
+   * Returns the builtin type number for the element at position `p`
+   * or 0 if the element has an announced type.
+   */
+  uint16_t type_nr_at(size_t p) const;
+
   /**
    * Returns @c true if `*this == other, otherwise false.
    */
@@ -69,6 +69,26 @@ struct pattern_type<T, true> {
     >::type;
 };
 
+// returns the atom a pattern starts with if its first element is a value
+inline optional<atom_value> leading_atom() {
+  return none;
+}
+
+template <class T, class... Ts>
+optional<atom_value> leading_atom(const T&, const Ts&...) {
+  return none;
+}
+
+template <class... Ts>
+optional<atom_value> leading_atom(const atom_value& x, const Ts&...) {
+  return x;
+}
+
+template <atom_value V, class... Ts>
+optional<atom_value> leading_atom(const atom_constant<V>&, const Ts&...) {
+  return V;
+}
+
 } // namespace detail
 } // namespace caf
 
@@ -159,7 +179,8 @@ auto on(const Ts&... xs)
     detail::type_list<
       typename detail::pattern_type<typename std::decay<Ts>::type>::type...>
     > {
-  return {detail::variadic_ctor{}, to_guard(xs)...};
+  return {detail::variadic_ctor{}, detail::leading_atom(xs...),
+          to_guard(xs)...};
 }
 
 /**
@@ -0,0 +1,315 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_POLICY_LOCK_FREE_WORK_STEALING_HPP
+#define CAF_POLICY_LOCK_FREE_WORK_STEALING_HPP
+
+#include <chrono>
+#include <thread>
+#include <random>
+#include <vector>
+#include <cstddef>
+
+#include "caf/resumable.hpp"
+
+#include "caf/detail/event_count.hpp"
+#include "caf/detail/cpu_topology.hpp"
+#include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/work_stealing_deque.hpp"
+
+namespace caf {
+namespace policy {
+
+/**
+ * Implements scheduling of actors via work stealing using a lock-free
+ * Chase-Lev deque per worker. Jobs created by a worker (`exec_later`) are
+ * pushed to and popped from the bottom of its deque without any locking,
+ * while idle workers steal from the top using a single CAS. Jobs enqueued
+ * by other threads and jobs that voluntarily released the CPU go to a
+ * separate FIFO inbox, since only the owner is allowed to push to its deque.
+ * Thieves check the inbox of their victim after its deque, i.e., a busy
+ * worker cannot starve jobs enqueued to it from the outside.
+ *
+ * Select this policy via `set_scheduler<policy::lock_free_work_stealing>()`.
+ *
+ * @extends scheduler_policy
+ */
+class lock_free_work_stealing {
+ public:
+  // A lock-free deque for jobs enqueued by the worker itself.
+  using deque_type = detail::work_stealing_deque<resumable>;
+
+  // A thread-safe FIFO queue for jobs enqueued from other threads.
+  using inbox_type = detail::double_ended_queue<resumable>;
+
+  // The coordinator has only a counter for round-robin enqueue to its workers.
+  struct coordinator_data {
+    std::atomic<size_t> next_worker;
+    // idle workers park here until new jobs arrive
+    detail::event_count parked;
+    inline coordinator_data() : next_worker(0) {
+      // nop
+    }
+  };
+
+  // Holds the job queues of a worker and a random number generator.
+  struct worker_data {
+    // Jobs enqueued by this worker, other workers steal from the top.
+    deque_type deque;
+    // Jobs enqueued by other threads or by resume_job_later.
+    inbox_type inbox;
+    // needed by our engine
+    std::random_device rdevice;
+    // needed to generate pseudo random numbers
+    std::default_random_engine rengine;
+    // other workers grouped by distance if this worker is pinned to a CPU
+    std::vector<std::vector<size_t>> victims;
+    // initialize random engine
+    inline worker_data() : rdevice(), rengine(rdevice()) {
+      // nop
+    }
+  };
+
+  // Convenience function to access the data field.
+  template <class WorkerOrCoordinator>
+  auto d(WorkerOrCoordinator* self) -> decltype(self->data()) {
+    return self->data();
+  }
+
+  // Goes on a raid in quest for a shiny new job.
+  template <class Worker>
+  resumable* try_steal(Worker* self) {
+    auto p = self->parent();
+    if (p->num_workers() < 2) {
+      // you can't steal from yourself, can you?
+      return nullptr;
+    }
+    auto steal_from = [&](size_t victim) -> resumable* {
+      auto& vd = d(p->worker_by_id(victim));
+      // steal oldest element from the victim's deque, fall back to its inbox
+      auto job = vd.deque.steal();
+      return job ? job : vd.inbox.take_head();
+    };
+    auto& tiers = d(self).victims;
+    if (tiers.empty()) {
+      size_t victim;
+      do {
+        // roll the dice to pick a victim other than ourselves
+        victim = d(self).rengine() % p->num_workers();
+      }
+      while (victim == self->id());
+      return steal_from(victim);
+    }
+    // prefer victims close to us to keep actors and their memory local
+    for (auto& tier : tiers) {
+      if (!tier.empty()) {
+        auto job = steal_from(tier[d(self).rengine() % tier.size()]);
+        if (job) {
+          return job;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  // Takes a job from our own queue or from any other worker.
+  template <class Worker>
+  resumable* try_take_any(Worker* self) {
+    auto job = d(self).deque.pop_bottom();
+    if (job) {
+      return job;
+    }
+    job = d(self).inbox.take_head();
+    if (job) {
+      return job;
+    }
+    auto p = self->parent();
+    for (size_t i = 0; i < p->num_workers(); ++i) {
+      if (i == self->id()) {
+        continue;
+      }
+      auto& vd = d(p->worker_by_id(i));
+      job = vd.deque.steal();
+      if (!job) {
+        job = vd.inbox.take_head();
+      }
+      if (job) {
+        return job;
+      }
+    }
+    return nullptr;
+  }
+
+  template <class Coordinator>
+  void central_enqueue(Coordinator* self, resumable* job) {
+    auto w = self->worker_by_id(d(self).next_worker++ % self->num_workers());
+    w->external_enqueue(job);
+  }
+
+  template <class Worker>
+  void external_enqueue(Worker* self, resumable* job) {
+    d(self).inbox.append(job);
+    d(self->parent()).parked.notify_one();
+  }
+
+  template <class Worker>
+  void internal_enqueue(Worker* self, resumable* job) {
+    d(self).deque.push_bottom(job);
+    // wakes an idle worker to steal from us
+    d(self->parent()).parked.notify_one();
+  }
+
+  template <class Worker>
+  void resume_job_later(Worker* self, resumable* job) {
+    // job has voluntarily released the CPU to let others run instead;
+    // putting it to the bottom of our deque would resume it right away
+    d(self).inbox.append(job);
+  }
+
+  /**
+   * Sets how many times an idle worker polls for new jobs before parking.
+   * Must be called before the scheduler is started.
+   */
+  static void set_spin_attempts(size_t num) {
+    spin_attempts_ref() = num;
+  }
+
+  static size_t spin_attempts() {
+    return spin_attempts_ref();
+  }
+
+  /**
+   * Enables pinning each worker to a CPU according to the machine's
+   * topology and stealing from nearby workers first.
+   * Must be called before the scheduler is started.
+   */
+  static void set_worker_pinning(bool value) {
+    worker_pinning_ref() = value;
+  }
+
+  static bool worker_pinning() {
+    return worker_pinning_ref();
+  }
+
+  template <class Worker>
+  void init_worker(Worker* self) {
+    if (!worker_pinning()) {
+      return;
+    }
+    // memory allocated by actors running on a pinned worker is placed on
+    // its NUMA node by the first-touch policy of the operating system
+    auto& topology = detail::cpu_topology::instance();
+    auto cpu = topology.placement(self->id());
+    if (cpu && detail::cpu_topology::pin_this_thread(cpu->id)) {
+      d(self).victims = topology.steal_tiers(self->id(),
+                                             self->parent()->num_workers());
+    }
+  }
+
+  template <class Worker>
+  resumable* dequeue(Worker* self) {
+    // we first assume an active work load and poll aggressively, stealing
+    // every 10 attempts; afterwards we park until an enqueue wakes us
+    // rather than sleeping, which delays new jobs by the sleep interval
+    resumable* job = nullptr;
+    auto attempts = spin_attempts();
+    for (size_t i = 0; i < attempts; ++i) {
+      job = d(self).deque.pop_bottom();
+      if (job) {
+        return job;
+      }
+      job = d(self).inbox.take_head();
+      if (job) {
+        return job;
+      }
+      if ((i % 10) == 0) {
+        job = try_steal(self);
+        if (job) {
+          return job;
+        }
+      }
+    }
+    auto& parked = d(self->parent()).parked;
+    for (;;) {
+      auto key = parked.prepare_wait();
+      // an enqueue before prepare_wait did not see us waiting,
+      // i.e., we have to check all queues before going to sleep
+      job = try_take_any(self);
+      if (job) {
+        parked.cancel_wait();
+        return job;
+      }
+      parked.wait(key);
+    }
+  }
+
+  template <class Worker>
+  void before_shutdown(Worker*) {
+    // nop
+  }
+
+  template <class Worker>
+  void before_resume(Worker*, resumable*) {
+    // nop
+  }
+
+  template <class Worker>
+  void after_resume(Worker*, resumable*) {
+    // nop
+  }
+
+  template <class Worker>
+  void after_completion(Worker*, resumable*) {
+    // nop
+  }
+
+  template <class Worker, class UnaryFunction>
+  void foreach_resumable(Worker* self, UnaryFunction f) {
+    // called after the worker's thread has been joined,
+    // i.e., we are the only thread accessing the deque
+    auto& wd = d(self);
+    for (auto job = wd.deque.pop_bottom(); job; job = wd.deque.pop_bottom()) {
+      f(job);
+    }
+    for (auto job = wd.inbox.take_head(); job; job = wd.inbox.take_head()) {
+      f(job);
+    }
+  }
+
+  template <class Coordinator, class UnaryFunction>
+  void foreach_central_resumable(Coordinator*, UnaryFunction) {
+    // nop
+  }
+
+ private:
+  static std::atomic<size_t>& spin_attempts_ref() {
+    static std::atomic<size_t> instance{100};
+    return instance;
+  }
+
+  static std::atomic<bool>& worker_pinning_ref() {
+    static std::atomic<bool> instance{false};
+    return instance;
+  }
+};
+
+} // namespace policy
+} // namespace caf
+
+#endif // CAF_POLICY_LOCK_FREE_WORK_STEALING_HPP
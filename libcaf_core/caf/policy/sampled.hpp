@@ -0,0 +1,64 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_POLICY_SAMPLED_HPP
+#define CAF_POLICY_SAMPLED_HPP
+
+#include "caf/resumable.hpp"
+
+namespace caf {
+
+namespace scheduler  {
+
+template <class>
+class sampling_coordinator;
+
+} // namespace scheduler
+
+namespace policy {
+
+/**
+ * An enhancement of CAF's scheduling policy which samples resumes of
+ * jobs and records their wall-clock and CPU time in the parent
+ * coordinator of the workers. Unlike `profiled`, the overhead for
+ * resumes that are not sampled is limited to incrementing a counter.
+ */
+template <class Policy>
+struct sampled : Policy {
+  using coordinator_type = scheduler::sampling_coordinator<sampled<Policy>>;
+
+  template <class Worker>
+  void before_resume(Worker* worker, resumable* job) {
+    Policy::before_resume(worker, job);
+    auto parent = static_cast<coordinator_type*>(worker->parent());
+    parent->start_sample(worker->id(), job);
+  }
+
+  template <class Worker>
+  void after_resume(Worker* worker, resumable* job) {
+    Policy::after_resume(worker, job);
+    auto parent = static_cast<coordinator_type*>(worker->parent());
+    parent->stop_sample(worker->id());
+  }
+};
+
+} // namespace policy
+} // namespace caf
+
+#endif // CAF_POLICY_SAMPLED_HPP
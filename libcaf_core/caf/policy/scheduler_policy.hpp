@@ -67,6 +67,12 @@ class scheduler_policy {
   template <class Worker>
   void resume_job_later(Worker* self, resumable* job);
 
+  /**
+   * Called by the worker itself before entering its scheduling loop.
+   */
+  template <class Worker>
+  void init_worker(Worker* self);
+
   /**
    * Blocks until a job could be dequeued.
    * Called by the worker itself to acquire a new job.
@@ -24,10 +24,13 @@
 #include <chrono>
 #include <thread>
 #include <random>
+#include <vector>
 #include <cstddef>
 
 #include "caf/resumable.hpp"
 
+#include "caf/detail/event_count.hpp"
+#include "caf/detail/cpu_topology.hpp"
 #include "caf/detail/double_ended_queue.hpp"
 
 namespace caf {
@@ -59,6 +62,8 @@ class work_stealing {
   // The coordinator has only a counter for round-robin enqueue to its workers.
   struct coordinator_data {
     std::atomic<size_t> next_worker;
+    // idle workers park here until new jobs arrive
+    detail::event_count parked;
     inline coordinator_data() : next_worker(0) {
       // nop
     }
@@ -73,6 +78,8 @@ class work_stealing {
     std::random_device rdevice;
     // needed to generate pseudo random numbers
     std::default_random_engine rengine;
+    // other workers grouped by distance if this worker is pinned to a CPU
+    std::vector<std::vector<size_t>> victims;
     // initialize random engine
     inline worker_data() : rdevice(), rengine(rdevice()) {
       // nop
@@ -93,14 +100,48 @@ class work_stealing {
       // you can't steal from yourself, can you?
       return nullptr;
     }
-    size_t victim;
-    do {
-      // roll the dice to pick a victim other than ourselves
-      victim = d(self).rengine() % p->num_workers();
+    auto& tiers = d(self).victims;
+    if (tiers.empty()) {
+      size_t victim;
+      do {
+        // roll the dice to pick a victim other than ourselves
+        victim = d(self).rengine() % p->num_workers();
+      }
+      while (victim == self->id());
+      // steal oldest element from the victim's queue
+      return d(p->worker_by_id(victim)).queue.take_tail();
+    }
+    // prefer victims close to us to keep actors and their memory local
+    for (auto& tier : tiers) {
+      if (!tier.empty()) {
+        auto victim = tier[d(self).rengine() % tier.size()];
+        auto job = d(p->worker_by_id(victim)).queue.take_tail();
+        if (job) {
+          return job;
+        }
+      }
     }
-    while (victim == self->id());
-    // steal oldest element from the victim's queue
-    return d(p->worker_by_id(victim)).queue.take_tail();
+    return nullptr;
+  }
+
+  // Takes a job from our own queue or from any other worker.
+  template <class Worker>
+  resumable* try_take_any(Worker* self) {
+    auto job = d(self).queue.take_head();
+    if (job) {
+      return job;
+    }
+    auto p = self->parent();
+    for (size_t i = 0; i < p->num_workers(); ++i) {
+      if (i == self->id()) {
+        continue;
+      }
+      job = d(p->worker_by_id(i)).queue.take_tail();
+      if (job) {
+        return job;
+      }
+    }
+    return nullptr;
   }
 
   template <class Coordinator>
@@ -112,11 +153,14 @@ class work_stealing {
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
     d(self).queue.append(job);
+    d(self->parent()).parked.notify_one();
   }
 
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job) {
     d(self).queue.prepend(job);
+    // wakes an idle worker to steal from us
+    d(self->parent()).parked.notify_one();
   }
 
   template <class Worker>
@@ -126,49 +170,77 @@ class work_stealing {
     d(self).queue.append(job);
   }
 
+  /**
+   * Sets how many times an idle worker polls for new jobs before parking.
+   * Must be called before the scheduler is started.
+   */
+  static void set_spin_attempts(size_t num) {
+    spin_attempts_ref() = num;
+  }
+
+  static size_t spin_attempts() {
+    return spin_attempts_ref();
+  }
+
+  /**
+   * Enables pinning each worker to a CPU according to the machine's
+   * topology and stealing from nearby workers first.
+   * Must be called before the scheduler is started.
+   */
+  static void set_worker_pinning(bool value) {
+    worker_pinning_ref() = value;
+  }
+
+  static bool worker_pinning() {
+    return worker_pinning_ref();
+  }
+
+  template <class Worker>
+  void init_worker(Worker* self) {
+    if (!worker_pinning()) {
+      return;
+    }
+    // memory allocated by actors running on a pinned worker is placed on
+    // its NUMA node by the first-touch policy of the operating system
+    auto& topology = detail::cpu_topology::instance();
+    auto cpu = topology.placement(self->id());
+    if (cpu && detail::cpu_topology::pin_this_thread(cpu->id)) {
+      d(self).victims = topology.steal_tiers(self->id(),
+                                             self->parent()->num_workers());
+    }
+  }
+
   template <class Worker>
   resumable* dequeue(Worker* self) {
-    // we wait for new jobs by polling our external queue: first, we
-    // assume an active work load on the machine and perform aggresive
-    // polling, then we relax our polling a bit and wait 50 us between
-    // dequeue attempts, finally we assume pretty much nothing is going
-    // on and poll every 10 ms; this strategy strives to minimize the
-    // downside of "busy waiting", which still performs much better than a
-    // "signalizing" implementation based on mutexes and conition variables
-    struct poll_strategy {
-      size_t attempts;
-      size_t step_size;
-      size_t steal_interval;
-      std::chrono::microseconds sleep_duration;
-    };
-    constexpr poll_strategy strategies[3] = {
-      // aggressive polling  (100x) without sleep interval
-      {100, 1, 10, std::chrono::microseconds{0}},
-      // moderate polling (500x) with 50 us sleep interval
-      {500, 1, 5,  std::chrono::microseconds{50}},
-      // relaxed polling (infinite attempts) with 10 ms sleep interval
-      {101, 0, 1,  std::chrono::microseconds{10000}}
-    };
+    // we first assume an active work load and poll aggressively, stealing
+    // every 10 attempts; afterwards we park until an enqueue wakes us
+    // rather than sleeping, which delays new jobs by the sleep interval
     resumable* job = nullptr;
-    for (auto& strat : strategies) {
-      for (size_t i = 0; i < strat.attempts; i += strat.step_size) {
-        job = d(self).queue.take_head();
+    auto attempts = spin_attempts();
+    for (size_t i = 0; i < attempts; ++i) {
+      job = d(self).queue.take_head();
+      if (job) {
+        return job;
+      }
+      if ((i % 10) == 0) {
+        job = try_steal(self);
         if (job) {
           return job;
         }
-        // try to steal every X poll attempts
-        if ((i % strat.steal_interval) == 0) {
-          job = try_steal(self);
-          if (job) {
-            return job;
-          }
-        }
-        std::this_thread::sleep_for(strat.sleep_duration);
       }
     }
-    // unreachable, because the last strategy loops
-    // until a job has been dequeued
-    return nullptr;
+    auto& parked = d(self->parent()).parked;
+    for (;;) {
+      auto key = parked.prepare_wait();
+      // an enqueue before prepare_wait did not see us waiting,
+      // i.e., we have to check all queues before going to sleep
+      job = try_take_any(self);
+      if (job) {
+        parked.cancel_wait();
+        return job;
+      }
+      parked.wait(key);
+    }
   }
 
   template <class Worker>
@@ -203,6 +275,17 @@ class work_stealing {
   void foreach_central_resumable(Coordinator*, UnaryFunction) {
     // nop
   }
+
+ private:
+  static std::atomic<size_t>& spin_attempts_ref() {
+    static std::atomic<size_t> instance{100};
+    return instance;
+  }
+
+  static std::atomic<bool>& worker_pinning_ref() {
+    static std::atomic<bool> instance{false};
+    return instance;
+  }
 };
 
 } // namespace policy
@@ -20,10 +20,13 @@
 #ifndef CAF_RESPONSE_PROMISE_HPP
 #define CAF_RESPONSE_PROMISE_HPP
 
+#include <type_traits>
+
 #include "caf/actor.hpp"
 #include "caf/message.hpp"
 #include "caf/actor_addr.hpp"
 #include "caf/message_id.hpp"
+#include "caf/mailbox_element.hpp"
 
 namespace caf {
 
@@ -57,7 +60,26 @@ class response_promise {
    */
   void deliver(message response_message) const;
 
+  /**
+   * Sends `{x, xs...}` as response message and invalidates this handle
+   * afterwards. Constructs the message in place, i.e., uses a single memory
+   * block for the message and its mailbox element.
+   */
+  template <class T, class... Ts>
+  typename std::enable_if<
+    !std::is_same<typename std::decay<T>::type, message>::value
+  >::type
+  deliver(T&& x, Ts&&... xs) const {
+    if (m_to) {
+      deliver_impl(mailbox_element::make_joint(m_from, m_id,
+                                               std::forward<T>(x),
+                                               std::forward<Ts>(xs)...));
+    }
+  }
+
  private:
+  void deliver_impl(mailbox_element_ptr what) const;
+
   actor_addr m_from;
   actor_addr m_to;
   message_id m_id;
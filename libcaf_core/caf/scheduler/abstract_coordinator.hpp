@@ -32,6 +32,8 @@
 #include "caf/duration.hpp"
 #include "caf/actor_addr.hpp"
 
+#include "caf/scheduler/timer_service.hpp"
+
 namespace caf {
 namespace scheduler {
 
@@ -61,13 +63,34 @@ class abstract_coordinator {
    */
   virtual void enqueue(resumable* what) = 0;
 
+  /**
+   * Enqueues `data` to `to` after `rel_time` and returns a handle
+   * for canceling the message via `timers().cancel(...)`.
+   */
   template <class Duration, class... Data>
-  void delayed_send(Duration rel_time, actor_addr from, channel to,
-                    message_id mid, message data) {
-    m_timer->enqueue(invalid_actor_addr, invalid_message_id,
-                     make_message(duration{rel_time}, std::move(from),
-                                  std::move(to), mid, std::move(data)),
-                     nullptr);
+  timer_service::handle delayed_send(Duration rel_time, actor_addr from,
+                                     channel to, message_id mid,
+                                     message data) {
+    return m_timers.schedule(duration{rel_time}, std::move(from),
+                             std::move(to), mid, std::move(data));
+  }
+
+  /**
+   * Enqueues `what` to `to` after `rel_time` and returns a handle
+   * for canceling the message via `timers().cancel(...)`.
+   */
+  template <class Duration>
+  timer_service::handle delayed_send(Duration rel_time, channel to,
+                                     mailbox_element_ptr what) {
+    return m_timers.schedule(duration{rel_time}, std::move(to),
+                             std::move(what));
+  }
+
+  /**
+   * Returns the timer service managing all delayed messages.
+   */
+  inline timer_service& timers() {
+    return m_timers;
   }
 
   inline size_t num_workers() const {
@@ -90,7 +113,7 @@ class abstract_coordinator {
     delete this;
   }
 
-  actor m_timer;
+  timer_service m_timers;
   actor m_printer;
 
   // ID of the worker receiving the next enqueue
@@ -0,0 +1,302 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_SCHEDULER_SAMPLING_COORDINATOR_HPP
+#define CAF_SCHEDULER_SAMPLING_COORDINATOR_HPP
+
+#include <time.h>
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <condition_variable>
+
+#include "caf/abstract_actor.hpp"
+
+#include "caf/policy/sampled.hpp"
+#include "caf/policy/work_stealing.hpp"
+
+#include "caf/scheduler/coordinator.hpp"
+
+#include "caf/detail/logging.hpp"
+#include "caf/detail/double_ended_queue.hpp" // CAF_CACHE_LINE_SIZE
+
+namespace caf {
+namespace scheduler {
+
+/**
+ * A coordinator which samples every n-th resume of its workers and
+ * periodically writes per-actor latency and CPU time histograms as
+ * JSON lines. Workers record samples into thread-local state and hand
+ * it over to a background thread without acquiring any lock.
+ */
+template <class Policy = policy::sampled<policy::work_stealing>>
+class sampling_coordinator : public coordinator<Policy> {
+ public:
+  using super = coordinator<Policy>;
+  using clock_type = std::chrono::steady_clock;
+
+  using nsec = std::chrono::nanoseconds;
+  using msec = std::chrono::milliseconds;
+
+  /**
+   * Number of buckets per histogram. Bucket `i` counts samples between
+   * `2^i` and `2^(i+1)` nanoseconds, the last bucket counts all larger ones.
+   */
+  static constexpr size_t num_buckets = 40;
+
+  using histogram = std::array<uint64_t, num_buckets>;
+
+  struct stats {
+    uint64_t samples = 0;
+    uint64_t wall_ns = 0;
+    uint64_t cpu_ns = 0;
+    histogram latency = histogram{{}};
+    histogram cpu = histogram{{}};
+
+    void add(uint64_t wall, uint64_t cpu_time) {
+      ++samples;
+      wall_ns += wall;
+      cpu_ns += cpu_time;
+      ++latency[bucket_of(wall)];
+      ++cpu[bucket_of(cpu_time)];
+    }
+
+    stats& operator+=(const stats& other) {
+      samples += other.samples;
+      wall_ns += other.wall_ns;
+      cpu_ns += other.cpu_ns;
+      for (size_t i = 0; i < num_buckets; ++i) {
+        latency[i] += other.latency[i];
+        cpu[i] += other.cpu[i];
+      }
+      return *this;
+    }
+  };
+
+  // samples of a single worker since its last hand-over
+  struct sample_set {
+    uint64_t resumes = 0;
+    stats total;
+    std::unordered_map<actor_id, stats> actors;
+  };
+
+  struct worker_state {
+    // accessed by the worker only
+    uint64_t resumes = 0;
+    uint64_t published_resumes = 0;
+    bool sampling = false;
+    actor_id sampled_actor = 0;
+    clock_type::time_point start;
+    uint64_t cpu_start = 0;
+    clock_type::time_point last_publish;
+    std::unique_ptr<sample_set> local;
+    // hand-over slot, set by the worker and cleared by the aggregator
+    std::atomic<sample_set*> published{nullptr};
+    // avoids false sharing between workers
+    char pad[CAF_CACHE_LINE_SIZE];
+  };
+
+  /**
+   * Creates a coordinator that samples every `rate`-th resume per worker
+   * and writes aggregated samples to `filename` every `res` milliseconds.
+   */
+  sampling_coordinator(const std::string& filename, size_t rate = 100,
+                       msec res = msec{1000},
+                       size_t nw = std::max(std::thread::hardware_concurrency(),
+                                            4u),
+                       size_t mt = std::numeric_limits<size_t>::max())
+      : super{nw, mt},
+        m_file{filename},
+        m_rate{std::max(rate, size_t{1})},
+        m_resolution{res},
+        m_done{false} {
+    if (!m_file) {
+      throw std::runtime_error{"failed to open CAF profiler file"};
+    }
+  }
+
+  ~sampling_coordinator() {
+    if (m_worker_states) {
+      for (size_t i = 0; i < this->num_workers(); ++i) {
+        delete m_worker_states[i].published.load();
+      }
+    }
+  }
+
+  void initialize() override {
+    // workers may start sampling as soon as they run
+    m_worker_states.reset(new worker_state[this->num_workers()]);
+    auto now = clock_type::now();
+    for (size_t i = 0; i < this->num_workers(); ++i) {
+      m_worker_states[i].local.reset(new sample_set);
+      m_worker_states[i].last_publish = now;
+    }
+    super::initialize();
+    m_aggregator = std::thread{[=] { aggregate_loop(); }};
+  }
+
+  void stop() override {
+    CAF_LOG_TRACE("");
+    super::stop();
+    { // lifetime scope of guard
+      std::lock_guard<std::mutex> guard{m_mtx};
+      m_done = true;
+    }
+    m_cv.notify_one();
+    m_aggregator.join();
+    // workers are done, i.e., we can safely collect their remaining samples
+    collect();
+    for (size_t i = 0; i < this->num_workers(); ++i) {
+      auto& w = m_worker_states[i];
+      w.local->resumes = w.resumes - w.published_resumes;
+      w.published = w.local.release();
+    }
+    collect();
+  }
+
+  void start_sample(size_t worker, resumable* job) {
+    auto& w = m_worker_states[worker];
+    w.sampling = w.resumes++ % m_rate == 0;
+    if (w.sampling) {
+      // the job might be resumed elsewhere or destroyed after
+      // its resume, i.e., stop_sample must not access it
+      auto ptr = dynamic_cast<abstract_actor*>(job);
+      w.sampled_actor = ptr ? ptr->id() : 0;
+      w.cpu_start = thread_cpu_time();
+      w.start = clock_type::now();
+    }
+  }
+
+  void stop_sample(size_t worker) {
+    auto& w = m_worker_states[worker];
+    if (!w.sampling) {
+      return;
+    }
+    auto now = clock_type::now();
+    auto wall = std::chrono::duration_cast<nsec>(now - w.start).count();
+    auto cpu = thread_cpu_time() - w.cpu_start;
+    auto& local = *w.local;
+    local.actors[w.sampled_actor].add(static_cast<uint64_t>(wall), cpu);
+    local.total.add(static_cast<uint64_t>(wall), cpu);
+    if (now - w.last_publish >= m_resolution) {
+      local.resumes = w.resumes - w.published_resumes;
+      sample_set* expected = nullptr;
+      // keeps accumulating if the aggregator did not pick up the last set
+      if (w.published.compare_exchange_strong(expected, w.local.get())) {
+        w.local.release();
+        w.local.reset(new sample_set);
+        w.published_resumes = w.resumes;
+        w.last_publish = now;
+      }
+    }
+  }
+
+ private:
+  static size_t bucket_of(uint64_t ns) {
+    size_t result = 0;
+    while (ns > 1 && result < num_buckets - 1) {
+      ns >>= 1;
+      ++result;
+    }
+    return result;
+  }
+
+  static uint64_t thread_cpu_time() {
+    ::timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000
+           + static_cast<uint64_t>(ts.tv_nsec);
+  }
+
+  void aggregate_loop() {
+    std::unique_lock<std::mutex> guard{m_mtx};
+    while (!m_done) {
+      m_cv.wait_for(guard, m_resolution);
+      collect();
+    }
+  }
+
+  // merges all published sample sets and writes them to the file
+  void collect() {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    auto clock = std::chrono::duration_cast<std::chrono::microseconds>(now);
+    std::unordered_map<actor_id, stats> actors;
+    for (size_t i = 0; i < this->num_workers(); ++i) {
+      std::unique_ptr<sample_set> ptr{
+        m_worker_states[i].published.exchange(nullptr)};
+      if (!ptr) {
+        continue;
+      }
+      m_file << "{\"clock\":" << clock.count()
+             << ",\"type\":\"worker\",\"id\":" << i
+             << ",\"resumes\":" << ptr->resumes;
+      record(ptr->total);
+      for (auto& kvp : ptr->actors) {
+        actors[kvp.first] += kvp.second;
+      }
+    }
+    for (auto& kvp : actors) {
+      m_file << "{\"clock\":" << clock.count()
+             << ",\"type\":\"actor\",\"id\":" << kvp.first;
+      record(kvp.second);
+    }
+    m_file.flush();
+  }
+
+  // writes the remainder of a JSON line, omitting trailing empty buckets
+  void record(const stats& x) {
+    auto print = [&](const char* name, const histogram& hist) {
+      auto last = num_buckets;
+      while (last > 0 && hist[last - 1] == 0) {
+        --last;
+      }
+      m_file << ",\"" << name << "\":[";
+      for (size_t i = 0; i < last; ++i) {
+        m_file << (i > 0 ? "," : "") << hist[i];
+      }
+      m_file << "]";
+    };
+    m_file << ",\"rate\":" << m_rate << ",\"samples\":" << x.samples
+           << ",\"wall_ns\":" << x.wall_ns << ",\"cpu_ns\":" << x.cpu_ns;
+    print("latency", x.latency);
+    print("cpu", x.cpu);
+    m_file << "}\n";
+  }
+
+  std::ofstream m_file;
+  size_t m_rate;
+  msec m_resolution;
+  std::unique_ptr<worker_state[]> m_worker_states;
+  std::thread m_aggregator;
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+  bool m_done;
+};
+
+} // namespace scheduler
+} // namespace caf
+
+#endif // CAF_SCHEDULER_SAMPLING_COORDINATOR_HPP
@@ -0,0 +1,117 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_SCHEDULER_THREAD_POOL_HPP
+#define CAF_SCHEDULER_THREAD_POOL_HPP
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+
+#include "caf/fwd.hpp"
+
+namespace caf {
+namespace scheduler {
+
+/**
+ * An elastic pool of threads for detached and blocking actors. Threads
+ * are created on demand, reused for subsequent tasks and terminate after
+ * being idle for a configurable time while more than the minimum number
+ * of threads is alive. Tasks never wait for a thread, since a detached
+ * actor occupies its thread for its whole lifetime. Once the maximum is
+ * reached, the pool starts surplus threads that terminate right after
+ * finishing their task instead of staying in the pool.
+ * Access the pool via `detail::singletons::get_blocking_pool()`.
+ */
+class thread_pool {
+ public:
+  friend class detail::singletons;
+
+  using task = std::function<void ()>;
+
+  /**
+   * A snapshot of the pool's state.
+   */
+  struct stats {
+    /// Number of alive threads.
+    size_t threads;
+    /// Number of threads waiting for a task.
+    size_t idle;
+    /// Number of tasks waiting for a thread.
+    size_t queued;
+    /// Highest number of alive threads so far.
+    size_t peak_threads;
+    /// Number of tasks that ran in a surplus thread because
+    /// the maximum number of threads were busy.
+    size_t saturated;
+  };
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /**
+   * Configures the number of threads that never time out, the maximum
+   * number of threads kept in the pool and how long surplus threads stay
+   * idle. The maximum does not limit the number of concurrently running
+   * tasks, i.e., the number of detached actors.
+   */
+  void configure(size_t min_threads, size_t max_threads,
+                 std::chrono::milliseconds idle_timeout);
+
+  /**
+   * Runs `f` in a pooled thread. Runs `f` in a new detached thread if the
+   * pool has been stopped.
+   */
+  void run(task f);
+
+  stats statistics() const;
+
+ private:
+  thread_pool();
+
+  ~thread_pool();
+
+  static thread_pool* create_singleton();
+
+  void initialize();
+
+  // wakes up all idle threads to let them terminate; busy
+  // threads terminate after finishing their current task
+  void stop();
+
+  inline void dispose() {
+    delete this;
+  }
+
+  struct state;
+
+  static void work(std::shared_ptr<state> st);
+
+  // shared with all threads, because they might outlive the pool
+  std::shared_ptr<state> m_state;
+};
+
+} // namespace scheduler
+} // namespace caf
+
+#endif // CAF_SCHEDULER_THREAD_POOL_HPP
@@ -0,0 +1,146 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_SCHEDULER_TIMER_SERVICE_HPP
+#define CAF_SCHEDULER_TIMER_SERVICE_HPP
+
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <condition_variable>
+
+#include "caf/channel.hpp"
+#include "caf/message.hpp"
+#include "caf/duration.hpp"
+#include "caf/actor_addr.hpp"
+#include "caf/message_id.hpp"
+#include "caf/ref_counted.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/mailbox_element.hpp"
+
+#include "caf/detail/timer_wheel.hpp"
+
+namespace caf {
+namespace scheduler {
+
+/**
+ * Manages delayed messages and timeouts using one hierarchical timing wheel
+ * per shard. Each shard is driven by its own thread that enqueues expired
+ * messages directly into the mailbox of the receiver. Callers are assigned
+ * to shards based on their thread ID.
+ */
+class timer_service {
+ public:
+  using clock_type = std::chrono::steady_clock;
+
+  /**
+   * The resolution of the timing wheels.
+   */
+  using tick_duration = std::chrono::milliseconds;
+
+  /**
+   * A pending delayed message.
+   */
+  class entry : public ref_counted, public detail::timer_wheel::node {
+   public:
+    entry(size_t shard_id, channel receiver, mailbox_element_ptr content);
+
+    ~entry();
+
+    size_t shard;
+    channel to;
+    mailbox_element_ptr element;
+  };
+
+  /**
+   * Identifies a pending delayed message for cancellation.
+   */
+  using handle = intrusive_ptr<entry>;
+
+  explicit timer_service(size_t num_shards);
+
+  ~timer_service();
+
+  timer_service(const timer_service&) = delete;
+  timer_service& operator=(const timer_service&) = delete;
+
+  /**
+   * Starts one thread per shard.
+   */
+  void start();
+
+  /**
+   * Stops all threads and drops all pending messages.
+   */
+  void stop();
+
+  /**
+   * Enqueues `msg` to `to` after `rel_time` has expired.
+   */
+  handle schedule(const duration& rel_time, actor_addr from, channel to,
+                  message_id mid, message msg);
+
+  /**
+   * Enqueues `what` to `to` after `rel_time` has expired.
+   */
+  handle schedule(const duration& rel_time, channel to,
+                  mailbox_element_ptr what);
+
+  /**
+   * Removes a pending message in O(1). Returns `false` if the message
+   * has already been delivered or canceled, `true` otherwise.
+   */
+  bool cancel(const handle& hdl);
+
+  inline size_t num_shards() const {
+    return m_shards.size();
+  }
+
+ private:
+  struct shard {
+    shard();
+    std::mutex mtx;
+    std::condition_variable cv;
+    detail::timer_wheel wheel;
+    // the tick the thread is sleeping until, 0 while awake
+    uint64_t wakeup;
+    bool running;
+    std::thread thread;
+  };
+
+  uint64_t current_tick() const;
+
+  uint64_t deadline_tick(const duration& rel_time) const;
+
+  clock_type::time_point time_of(uint64_t tick) const;
+
+  void run(shard& sh);
+
+  clock_type::time_point m_epoch;
+  std::vector<std::unique_ptr<shard>> m_shards;
+};
+
+} // namespace scheduler
+} // namespace caf
+
+#endif // CAF_SCHEDULER_TIMER_SERVICE_HPP
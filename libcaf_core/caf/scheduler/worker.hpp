@@ -75,11 +75,17 @@ class worker : public execution_unit {
   /**
    * Enqueues a new job to the worker's queue from an internal
    * source, i.e., a job that is currently executed by this worker.
-   * @warning Must not be called from other threads.
+   * Calls from other threads fall back to `external_enqueue`.
    */
   void exec_later(job_ptr job) override {
     CAF_ASSERT(job != nullptr);
     CAF_LOG_TRACE("id = " << id() << " actor id " << id_of(job));
+    // other threads pass this worker as well, e.g., when delivering
+    // a response promise on behalf of an actor running here
+    if (current() != this) {
+      m_policy.external_enqueue(this, job);
+      return;
+    }
     m_policy.internal_enqueue(this, job);
   }
 
@@ -117,8 +123,16 @@ class worker : public execution_unit {
   }
 
  private:
+  // returns the worker running on the calling thread, if any
+  static worker*& current() {
+    thread_local worker* result = nullptr;
+    return result;
+  }
+
   void run() {
     CAF_LOG_TRACE("worker with ID " << m_id);
+    current() = this;
+    m_policy.init_worker(this);
     // scheduling loop
     for (;;) {
       auto job = m_policy.dequeue(this);
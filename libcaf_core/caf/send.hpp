@@ -26,6 +26,7 @@
 #include "caf/actor_cast.hpp"
 #include "caf/actor_addr.hpp"
 #include "caf/message_id.hpp"
+#include "caf/mailbox_element.hpp"
 #include "caf/message_priority.hpp"
 #include "caf/typed_actor.hpp"
 #include "caf/system_messages.hpp"
@@ -33,6 +34,29 @@
 
 namespace caf {
 
+namespace detail {
+
+inline void send_as_impl(const actor& from, message_id mid,
+                         const channel& to, message msg = message{}) {
+  to->enqueue(from.address(), mid, std::move(msg), nullptr);
+}
+
+// constructs the content in place, i.e., uses a single memory block
+// for both the mailbox element and the message data
+template <class T, class... Ts>
+typename std::enable_if<
+  !std::is_same<typename std::decay<T>::type, message>::value
+>::type
+send_as_impl(const actor& from, message_id mid, const channel& to,
+             T&& x, Ts&&... xs) {
+  to->enqueue(mailbox_element::make_joint(from.address(), mid,
+                                          std::forward<T>(x),
+                                          std::forward<Ts>(xs)...),
+              nullptr);
+}
+
+} // namespace detail
+
 /**
  * Sends `to` a message under the identity of `from` with priority `prio`.
  */
@@ -43,9 +67,11 @@ void send_as(const actor& from, message_priority prio,
     return;
   }
   message_id mid;
-  to->enqueue(from.address(),
-              prio == message_priority::high ? mid.with_high_priority() : mid,
-              make_message(std::forward<Ts>(xs)...), nullptr);
+  detail::send_as_impl(from,
+                       prio == message_priority::high
+                       ? mid.with_high_priority()
+                       : mid,
+                       to, std::forward<Ts>(xs)...);
 }
 
 /**
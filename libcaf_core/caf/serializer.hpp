@@ -26,6 +26,8 @@
 #include "caf/uniform_type_info.hpp"
 #include "caf/primitive_variant.hpp"
 
+#include "caf/detail/type_traits.hpp"
+
 namespace caf {
 
 class actor_namespace;
@@ -80,11 +82,20 @@ class serializer {
    */
   virtual void write_raw(size_t num_bytes, const void* data) = 0;
 
+  /**
+   * Returns whether this serializer stores integers as their raw bytes in
+   * host byte order, i.e., whether `write_raw(sizeof(x), &x)` is equivalent
+   * to `write_value(x)` for any integer `x`. Allows callers to skip
+   * boxing integers in a `primitive_variant`.
+   */
+  virtual bool writes_raw_integers() const;
+
   inline actor_namespace* get_namespace() { return m_namespace; }
 
   template <class T>
   inline serializer& write(const T& val) {
-    write_value(val);
+    std::integral_constant<bool, detail::is_raw_integer<T>::value> token;
+    write_impl(val, token);
     return *this;
   }
 
@@ -95,6 +106,20 @@ class serializer {
   }
 
  private:
+  template <class T>
+  void write_impl(const T& val, std::true_type) {
+    if (writes_raw_integers()) {
+      write_raw(sizeof(T), &val);
+    } else {
+      write_value(val);
+    }
+  }
+
+  template <class T>
+  void write_impl(const T& val, std::false_type) {
+    write_value(val);
+  }
+
   actor_namespace* m_namespace;
 };
 
@@ -192,6 +192,26 @@ actor spawn_in_group(const group& grp, Ts&&... xs) {
                std::forward<Ts>(xs)...);
 }
 
+/**
+ * Returns a new actor of type `C` with a mailbox limited
+ * by `bounds` using `xs` as constructor arguments.
+ */
+template <class C, spawn_options Os = no_spawn_options, class... Ts>
+actor spawn_bounded(const mailbox_bounds& bounds, Ts&&... xs) {
+  return spawn_class<C, Os>(nullptr, bounds, std::forward<Ts>(xs)...);
+}
+
+/**
+ * Returns a new functor-based actor with a mailbox limited by `bounds`.
+ * The first element of `xs` must be the functor, the remaining
+ * arguments its arguments.
+ */
+template <spawn_options Os = no_spawn_options, class... Ts>
+actor spawn_bounded(const mailbox_bounds& bounds, Ts&&... xs) {
+  static_assert(sizeof...(Ts) > 0, "too few arguments provided");
+  return spawn_functor<Os>(nullptr, bounds, std::forward<Ts>(xs)...);
+}
+
 /**
  * Base class for strongly typed actors using a functor-based implementation.
  */
@@ -20,6 +20,8 @@
 #ifndef CAF_SPAWN_OPTIONS_HPP
 #define CAF_SPAWN_OPTIONS_HPP
 
+#include <cstddef>
+
 namespace caf {
 
 /**
@@ -165,6 +167,56 @@ constexpr bool has_lazy_init_flag(spawn_options opts) {
   return has_spawn_option(opts, lazy_init);
 }
 
+/**
+ * Denotes how an actor with a bounded mailbox handles a message
+ * that arrives while its mailbox is full.
+ */
+enum class mailbox_overflow {
+  /**
+   * Silently discards the new message.
+   */
+  drop_newest,
+
+  /**
+   * Accepts the new message but silently discards the oldest messages
+   * in excess of the capacity before the actor dequeues its next message.
+   * Since only the actor itself can remove messages from its mailbox,
+   * new messages are discarded as with `drop_newest` once the mailbox
+   * holds twice its capacity, i.e., until the actor catches up.
+   */
+  drop_oldest,
+
+  /**
+   * Discards the new message and answers synchronous requests with
+   * a `sync_exited_msg` using the reason `exit_reason::mailbox_full`.
+   */
+  reject_requests,
+
+  /**
+   * Same as `reject_requests`, but also sends a `mailbox_full_atom`
+   * to the sender of a discarded asynchronous message.
+   */
+  notify_sender
+};
+
+/**
+ * Limits the number of messages waiting in the mailbox of a new actor.
+ * Passing an instance of this type to `spawn_bounded` configures the
+ * actor before it is launched. The bound is soft, i.e., concurrent senders
+ * can overshoot the capacity by at most one message each. Responses,
+ * high-priority messages and system messages such as `exit_msg` or
+ * `down_msg` are never discarded.
+ */
+struct mailbox_bounds {
+  size_t capacity;
+  mailbox_overflow policy;
+
+  template <class T>
+  void operator()(T* ptr) const {
+    ptr->bound_mailbox(capacity, policy);
+  }
+};
+
 /** @} */
 
 /** @cond PRIVATE */
@@ -250,6 +250,35 @@ class uniform_type_info {
    */
   virtual message as_message(void* instance) const = 0;
 
+  /**
+   * Returns the size of an instance in bytes or 0 if this type does not
+   * support construction in place, in which case the member functions
+   * `construct`, `copy_construct` and `destroy` must not be called.
+   */
+  virtual size_t instance_size() const;
+
+  /**
+   * Returns the alignment requirement of an instance in bytes.
+   */
+  virtual size_t instance_alignment() const;
+
+  /**
+   * Default-constructs an instance of this type at `storage`.
+   * @pre `storage` has `instance_size()` bytes and is properly aligned.
+   */
+  virtual void construct(void* storage) const;
+
+  /**
+   * Constructs a copy of `other` at `storage`.
+   * @pre `storage` has `instance_size()` bytes and is properly aligned.
+   */
+  virtual void copy_construct(void* storage, const void* other) const;
+
+  /**
+   * Destroys `instance` without releasing its memory.
+   */
+  virtual void destroy(void* instance) const;
+
   /**
    * Returns a unique number for builtin types or 0.
    */
@@ -46,6 +46,13 @@ void abstract_channel::enqueue(mailbox_element_ptr what, execution_unit* host) {
   enqueue(what->sender, what->mid, what->msg, host);
 }
 
+void abstract_channel::enqueue_batch(mailbox_batch what,
+                                     execution_unit* host) {
+  while (!what.empty()) {
+    enqueue(what.pop_front(), host);
+  }
+}
+
 bool abstract_channel::is_remote() const {
   return m_node != singletons::get_node_id();
 }
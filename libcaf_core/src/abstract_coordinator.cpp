@@ -21,9 +21,8 @@
 
 #include <thread>
 #include <atomic>
-#include <chrono>
 #include <iostream>
-#include <condition_variable>
+#include <algorithm>
 
 #include "caf/on.hpp"
 #include "caf/send.hpp"
@@ -49,94 +48,6 @@ namespace scheduler {
 
 namespace {
 
-using hrc = std::chrono::high_resolution_clock;
-
-struct delayed_msg {
-  actor_addr from;
-  channel to;
-  message_id mid;
-  message msg;
-};
-
-inline void deliver(delayed_msg& dm) {
-  dm.to->enqueue(dm.from, dm.mid, std::move(dm.msg), nullptr);
-}
-
-template <class Map, class... Ts>
-inline void insert_dmsg(Map& storage, const duration& d, Ts&&... xs) {
-  auto tout = hrc::now();
-  tout += d;
-  delayed_msg dmsg{std::forward<Ts>(xs)...};
-  storage.insert(std::make_pair(std::move(tout), std::move(dmsg)));
-}
-
-class timer_actor : public blocking_actor {
- public:
-  inline mailbox_element_ptr dequeue() {
-    blocking_actor::await_data();
-    return next_message();
-  }
-
-  bool await_data(const hrc::time_point& tp) {
-    if (has_next_message()) {
-      return true;
-    }
-    return mailbox().synchronized_await(m_mtx, m_cv, tp);
-  }
-
-  mailbox_element_ptr try_dequeue(const hrc::time_point& tp) {
-    if (await_data(tp)) {
-      return next_message();
-    }
-    return mailbox_element_ptr{};
-  }
-
-  void act() override {
-    trap_exit(true);
-    // setup & local variables
-    bool received_exit = false;
-    mailbox_element_ptr msg_ptr;
-    std::multimap<hrc::time_point, delayed_msg> messages;
-    // message handling rules
-    message_handler mfun{
-      [&](const duration& d, actor_addr& from, channel& to,
-          message_id mid, message& msg) {
-         insert_dmsg(messages, d, std::move(from),
-                     std::move(to), mid, std::move(msg));
-      },
-      [&](const exit_msg&) {
-        received_exit = true;
-      },
-      others >> [&] {
-        CAF_LOG_ERROR("unexpected: " << to_string(msg_ptr->msg));
-      }
-    };
-    // loop
-    while (!received_exit) {
-      while (!msg_ptr) {
-        if (messages.empty())
-          msg_ptr = dequeue();
-        else {
-          auto tout = hrc::now();
-          // handle timeouts (send messages)
-          auto it = messages.begin();
-          while (it != messages.end() && (it->first) <= tout) {
-            deliver(it->second);
-            messages.erase(it);
-            it = messages.begin();
-          }
-          // wait for next message or next timeout
-          if (it != messages.end()) {
-            msg_ptr = try_dequeue(it->first);
-          }
-        }
-      }
-      mfun(msg_ptr->msg);
-      msg_ptr.reset();
-    }
-  }
-};
-
 void printer_loop(blocking_actor* self) {
   self->trap_exit(true);
   std::map<actor_addr, std::string> out;
@@ -207,20 +118,18 @@ abstract_coordinator* abstract_coordinator::create_singleton() {
 
 void abstract_coordinator::initialize() {
   CAF_LOG_TRACE("");
-  // launch utility actors
-  m_timer = spawn<timer_actor, hidden + detached + blocking_api>();
+  // launch timer threads and utility actors
+  m_timers.start();
   m_printer = spawn<hidden + detached + blocking_api>(printer_loop);
 }
 
 void abstract_coordinator::stop_actors() {
   CAF_LOG_TRACE("");
+  m_timers.stop();
   scoped_actor self{true};
-  self->monitor(m_timer);
   self->monitor(m_printer);
-  anon_send_exit(m_timer, exit_reason::user_shutdown);
   anon_send_exit(m_printer, exit_reason::user_shutdown);
-  int i = 0;
-  self->receive_for(i, 2)(
+  self->receive(
     [](const down_msg&) {
       // nop
     }
@@ -228,7 +137,9 @@ void abstract_coordinator::stop_actors() {
 }
 
 abstract_coordinator::abstract_coordinator(size_t nw)
-    : m_next_worker(0),
+    // use one timer thread per eight workers
+    : m_timers(std::max<size_t>(1, nw / 8)),
+      m_next_worker(0),
       m_num_workers(nw) {
   // nop
 }
@@ -50,6 +50,11 @@ void actor_companion::enqueue(const actor_addr& sender, message_id mid,
   enqueue(std::move(ptr), eu);
 }
 
+void actor_companion::enqueue_batch(mailbox_batch what, execution_unit* eu) {
+  // each message is passed to the enqueue handler individually
+  abstract_channel::enqueue_batch(std::move(what), eu);
+}
+
 void actor_companion::initialize() {
   // nop
 }
@@ -19,55 +19,316 @@
 
 #include <mutex>
 #include <limits>
+#include <vector>
 #include <stdexcept>
 
 #include "caf/attachable.hpp"
 #include "caf/exit_reason.hpp"
 #include "caf/detail/actor_registry.hpp"
 
-#include "caf/locks.hpp"
 #include "caf/detail/logging.hpp"
-#include "caf/detail/shared_spinlock.hpp"
 
 namespace caf {
 namespace detail {
 
 namespace {
 
-using exclusive_guard = unique_lock<shared_spinlock>;
-using shared_guard = shared_lock<shared_spinlock>;
+constexpr size_t s_num_shards = 64;
+constexpr size_t s_min_capacity = 16;  // must be a power of two
+constexpr size_t s_num_tombstones = 64; // exit reasons remembered per shard
+
+constexpr actor_id s_empty_key = invalid_actor_id;
+constexpr actor_id s_deleted_key = std::numeric_limits<actor_id>::max();
+
+struct slot {
+  std::atomic<actor_id> key;
+  std::atomic<abstract_actor*> value;
+};
+
+struct table {
+  explicit table(size_t cap) : capacity(cap), slots(new slot[cap]) {
+    for (size_t i = 0; i < cap; ++i) {
+      slots[i].key = s_empty_key;
+      slots[i].value = nullptr;
+    }
+  }
+
+  // returns the first slot on the probe sequence for `key`
+  size_t first(actor_id key) const {
+    // IDs are assigned sequentially, i.e., consecutive keys of a shard differ
+    // by s_num_shards and a multiplicative hash spreads them evenly
+    return ((key / s_num_shards) * 2654435761u) & (capacity - 1);
+  }
+
+  size_t next(size_t pos) const {
+    return (pos + 1) & (capacity - 1);
+  }
+
+  size_t capacity;
+  std::unique_ptr<slot[]> slots;
+};
+
+using table_ptr = std::unique_ptr<table>;
+
+inline uint64_t make_tombstone(actor_id key, uint32_t reason) {
+  return (static_cast<uint64_t>(key) << 32) | reason;
+}
 
 } // namespace <anonymous>
 
+/*
+ * Readers announce themselves via `m_readers` before loading any slot.
+ * Writers never release an actor or a table right away. Instead, they retire
+ * removed objects and release them only after observing zero readers. Slot
+ * operations and the reader count use sequential consistency, so a writer
+ * that observes zero readers knows that any later reader sees the removal.
+ * Writers as well as the last leaving reader try to release retired objects
+ * after unlocking the shard. Whoever fails to acquire the lock leaves this
+ * task to the owner of the lock, which checks again after unlocking. Hence,
+ * retired objects never outlive the last reader that could access them.
+ */
+class actor_registry::shard {
+ public:
+  // retired objects released after unlocking the shard
+  struct garbage {
+    std::vector<abstract_actor_ptr> actors;
+    std::vector<table_ptr> tables;
+  };
+
+  shard()
+      : m_table(new table(s_min_capacity)),
+        m_size(0),
+        m_used(0),
+        m_readers(0),
+        m_has_garbage(false),
+        m_tombstone_pos(0) {
+    for (auto& x : m_tombstones) {
+      x = 0;
+    }
+  }
+
+  ~shard() {
+    auto tbl = m_table.load();
+    for (size_t i = 0; i < tbl->capacity; ++i) {
+      auto ptr = tbl->slots[i].value.load();
+      if (ptr) {
+        intrusive_ptr_release(ptr);
+      }
+    }
+    delete tbl;
+  }
+
+  value_type get(actor_id key) const {
+    ++m_readers;
+    auto tbl = m_table.load();
+    auto pos = tbl->first(key);
+    for (;;) {
+      auto& x = tbl->slots[pos];
+      auto k = x.key.load();
+      if (k == s_empty_key) {
+        break;
+      }
+      if (k == key) {
+        auto ptr = x.value.load();
+        // the slot might have been reused after reading its key
+        if (ptr && x.key.load() == key) {
+          value_type result{ptr, exit_reason::not_exited};
+          leave();
+          return result;
+        }
+        break;
+      }
+      pos = tbl->next(pos);
+    }
+    leave();
+    for (auto& x : m_tombstones) {
+      auto tombstone = x.load(std::memory_order_relaxed);
+      if (static_cast<actor_id>(tombstone >> 32) == key) {
+        return {nullptr, static_cast<uint32_t>(tombstone)};
+      }
+    }
+    return {nullptr, exit_reason::unknown};
+  }
+
+  bool put(actor_id key, const abstract_actor_ptr& value) {
+    // avoid locking when re-registering an actor, e.g., for each
+    // outgoing message of a local actor in BASP
+    if (get(key).first) {
+      return false;
+    }
+    auto result = put_impl(key, value);
+    try_collect();
+    return result;
+  }
+
+  bool erase(actor_id key, uint32_t reason) {
+    auto result = erase_impl(key, reason);
+    try_collect();
+    return result;
+  }
+
+  size_t size() const {
+    return m_size.load(std::memory_order_relaxed);
+  }
+
+ private:
+  bool put_impl(actor_id key, const abstract_actor_ptr& value) {
+    std::lock_guard<std::mutex> guard{m_mtx};
+    auto tbl = m_table.load();
+    auto pos = tbl->first(key);
+    slot* free_slot = nullptr;
+    for (;;) {
+      auto& x = tbl->slots[pos];
+      auto k = x.key.load();
+      if (k == key) {
+        return false;
+      }
+      if (k == s_deleted_key && !free_slot) {
+        free_slot = &x;
+      } else if (k == s_empty_key) {
+        if (!free_slot) {
+          free_slot = &x;
+          ++m_used;
+        }
+        break;
+      }
+      pos = tbl->next(pos);
+    }
+    intrusive_ptr_add_ref(value.get());
+    free_slot->value = value.get();
+    free_slot->key = key;
+    ++m_size;
+    if (m_used * 4 > tbl->capacity * 3) {
+      rehash();
+    }
+    return true;
+  }
+
+  bool erase_impl(actor_id key, uint32_t reason) {
+    std::lock_guard<std::mutex> guard{m_mtx};
+    auto tbl = m_table.load();
+    auto pos = tbl->first(key);
+    for (;;) {
+      auto& x = tbl->slots[pos];
+      auto k = x.key.load();
+      if (k == s_empty_key) {
+        return false;
+      }
+      if (k == key) {
+        m_retired_actors.emplace_back(x.value.load(), false);
+        m_has_garbage = true;
+        x.value = nullptr;
+        x.key = s_deleted_key;
+        break;
+      }
+      pos = tbl->next(pos);
+    }
+    --m_size;
+    m_tombstones[m_tombstone_pos].store(make_tombstone(key, reason),
+                                        std::memory_order_relaxed);
+    m_tombstone_pos = (m_tombstone_pos + 1) % s_num_tombstones;
+    // shrink tables that are mostly empty
+    if (tbl->capacity > s_min_capacity && m_size * 8 < tbl->capacity) {
+      rehash();
+    }
+    return true;
+  }
+
+  // replaces the current table with one that has no deleted slots
+  void rehash() {
+    auto old_tbl = m_table.load();
+    auto cap = s_min_capacity;
+    while (cap < m_size * 2) {
+      cap *= 2;
+    }
+    auto tbl = new table(cap);
+    for (size_t i = 0; i < old_tbl->capacity; ++i) {
+      auto& x = old_tbl->slots[i];
+      auto k = x.key.load();
+      if (k != s_empty_key && k != s_deleted_key) {
+        auto pos = tbl->first(k);
+        while (tbl->slots[pos].key.load() != s_empty_key) {
+          pos = tbl->next(pos);
+        }
+        tbl->slots[pos].value = x.value.load();
+        tbl->slots[pos].key = k;
+      }
+    }
+    m_used = m_size.load();
+    m_table = tbl;
+    m_retired_tables.emplace_back(old_tbl);
+    m_has_garbage = true;
+  }
+
+  void leave() const {
+    if (--m_readers == 0 && m_has_garbage.load()) {
+      try_collect();
+    }
+  }
+
+  // releases retired objects unless a reader can still access them
+  // or another thread holds the lock and checks again afterwards
+  void try_collect() const {
+    while (m_readers.load() == 0 && m_has_garbage.load()) {
+      garbage trash;
+      { // lifetime scope of guard
+        std::unique_lock<std::mutex> guard{m_mtx, std::try_to_lock};
+        if (!guard.owns_lock()) {
+          return;
+        }
+        if (m_readers.load() == 0) {
+          trash.actors.swap(m_retired_actors);
+          trash.tables.swap(m_retired_tables);
+          m_has_garbage = false;
+        }
+      }
+    }
+  }
+
+  // readers release retired objects as well, i.e., the
+  // lock and the retired objects are mutable
+  mutable std::mutex m_mtx;
+  std::atomic<table*> m_table;
+  std::atomic<size_t> m_size;
+  size_t m_used; // number of slots with a deleted or valid key
+  mutable std::atomic<size_t> m_readers;
+  mutable std::atomic<bool> m_has_garbage;
+  mutable std::vector<abstract_actor_ptr> m_retired_actors;
+  mutable std::vector<table_ptr> m_retired_tables;
+  std::atomic<uint64_t> m_tombstones[s_num_tombstones];
+  size_t m_tombstone_pos;
+};
+
 actor_registry::~actor_registry() {
   // nop
 }
 
-actor_registry::actor_registry() : m_running(0), m_ids(1) {
+actor_registry::actor_registry()
+    : m_running(0),
+      m_ids(1),
+      m_shards(new shard[s_num_shards]) {
   // nop
 }
 
+actor_registry::shard& actor_registry::shard_for(actor_id key) const {
+  return m_shards[key % s_num_shards];
+}
+
 actor_registry::value_type actor_registry::get_entry(actor_id key) const {
-  shared_guard guard(m_instances_mtx);
-  auto i = m_entries.find(key);
-  if (i != m_entries.end()) {
-    return i->second;
+  auto result = shard_for(key).get(key);
+  if (!result.first && result.second == exit_reason::unknown) {
+    CAF_LOG_DEBUG("key not found, assume the actor no longer exists: " << key);
   }
-  CAF_LOG_DEBUG("key not found, assume the actor no longer exists: " << key);
-  return {nullptr, exit_reason::unknown};
+  return result;
 }
 
 void actor_registry::put(actor_id key, const abstract_actor_ptr& val) {
   if (val == nullptr) {
     return;
   }
-  auto entry = std::make_pair(key, value_type(val, exit_reason::not_exited));
-  { // lifetime scope of guard
-    exclusive_guard guard(m_instances_mtx);
-    if (!m_entries.insert(entry).second) {
-      // already defined
-      return;
-    }
+  if (!shard_for(key).put(key, val)) {
+    // already defined
+    return;
   }
   // attach functor without lock
   CAF_LOG_INFO("added actor with ID " << key);
@@ -76,16 +337,19 @@ void actor_registry::put(actor_id key, const abstract_actor_ptr& val) {
 }
 
 void actor_registry::erase(actor_id key, uint32_t reason) {
-  exclusive_guard guard(m_instances_mtx);
-  auto i = m_entries.find(key);
-  if (i != m_entries.end()) {
-    auto& entry = i->second;
+  if (shard_for(key).erase(key, reason)) {
     CAF_LOG_INFO("erased actor with ID " << key << ", reason " << reason);
-    entry.first = nullptr;
-    entry.second = reason;
   }
 }
 
+size_t actor_registry::size() const {
+  size_t result = 0;
+  for (size_t i = 0; i < s_num_shards; ++i) {
+    result += m_shards[i].size();
+  }
+  return result;
+}
+
 uint32_t actor_registry::next_id() {
   return ++m_ids;
 }
@@ -19,6 +19,8 @@
 
 #include "caf/detail/behavior_impl.hpp"
 
+#include <algorithm>
+
 #include "caf/message_handler.hpp"
 
 namespace caf {
@@ -33,6 +35,10 @@ class combinator final : public behavior_impl {
     return res ? res : second->invoke(arg);
   }
 
+  bool may_match(uint32_t type_token) const {
+    return first->may_match(type_token) || second->may_match(type_token);
+  }
+
   void handle_timeout() {
     // the second behavior overrides the timeout handling of
     // first behavior
@@ -61,8 +67,16 @@ class combinator final : public behavior_impl {
   pointer second;
 };
 
+template <class T>
+bool entry_less(const T& x, const T& y) {
+  return std::tie(x.type_token, x.has_atom, x.atom)
+         < std::tie(y.type_token, y.has_atom, y.atom);
+}
+
 } // namespace <anonymous>
 
+constexpr size_t behavior_impl::dispatch_threshold;
+
 behavior_impl::~behavior_impl() {
   // nop
 }
@@ -70,16 +84,26 @@ behavior_impl::~behavior_impl() {
 behavior_impl::behavior_impl(duration tout)
     : m_timeout(tout),
       m_begin(nullptr),
-      m_end(nullptr) {
+      m_end(nullptr),
+      m_num_wildcards(0) {
   // nop
 }
 
 bhvr_invoke_result behavior_impl::invoke(message& msg) {
   auto msg_token = msg.type_token();
   bhvr_invoke_result res;
-  for (auto i = m_begin; i != m_end; ++i) {
-    if ((i->has_wildcard || i->type_token == msg_token)
-        && i->ptr->invoke(res, msg) != match_case::no_match) {
+  if (m_dispatch.empty()) {
+    for (auto i = m_begin; i != m_end; ++i) {
+      if ((i->has_wildcard || i->type_token == msg_token)
+          && i->ptr->invoke(res, msg) != match_case::no_match) {
+        return res;
+      }
+    }
+    return none;
+  }
+  auto range = candidates(msg_token, msg);
+  for (auto i = range.first; i != range.second; ++i) {
+    if ((*i)->ptr->invoke(res, msg) != match_case::no_match) {
       return res;
     }
   }
@@ -90,6 +114,103 @@ void behavior_impl::handle_timeout() {
   // nop
 }
 
+bool behavior_impl::may_match(uint32_t type_token) const {
+  if (!m_dispatch.empty()) {
+    if (m_num_wildcards > 0) {
+      return true;
+    }
+    dispatch_entry probe{type_token, false, atom_value{}, 0, 0};
+    auto i = std::lower_bound(m_dispatch.begin(), m_dispatch.end(), probe,
+                              entry_less<dispatch_entry>);
+    return i != m_dispatch.end() && i->type_token == type_token;
+  }
+  for (auto i = m_begin; i != m_end; ++i) {
+    if (i->has_wildcard || i->type_token == type_token) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void behavior_impl::init_dispatch_table() {
+  if (static_cast<size_t>(m_end - m_begin) < dispatch_threshold) {
+    return;
+  }
+  auto is_candidate = [](const match_case_info& x, const dispatch_entry& e) {
+    if (x.has_wildcard) {
+      return true;
+    }
+    if (x.type_token != e.type_token) {
+      return false;
+    }
+    // cases starting with a different (or any) atom never match
+    auto& la = x.ptr->leading_atom();
+    return !la || (e.has_atom && *la == e.atom);
+  };
+  for (auto i = m_begin; i != m_end; ++i) {
+    if (i->has_wildcard) {
+      m_candidates.push_back(i);
+    } else {
+      m_dispatch.push_back(dispatch_entry{i->type_token, false,
+                                          atom_value{}, 0, 0});
+      auto& la = i->ptr->leading_atom();
+      if (la) {
+        m_dispatch.push_back(dispatch_entry{i->type_token, true, *la, 0, 0});
+      }
+    }
+  }
+  m_num_wildcards = static_cast<uint32_t>(m_candidates.size());
+  std::sort(m_dispatch.begin(), m_dispatch.end(), entry_less<dispatch_entry>);
+  auto eq = [](const dispatch_entry& x, const dispatch_entry& y) {
+    return !entry_less(x, y) && !entry_less(y, x);
+  };
+  m_dispatch.erase(std::unique(m_dispatch.begin(), m_dispatch.end(), eq),
+                   m_dispatch.end());
+  if (m_dispatch.empty()) {
+    // only wildcards, nothing to gain from a table
+    m_candidates.clear();
+    m_num_wildcards = 0;
+    return;
+  }
+  for (auto& e : m_dispatch) {
+    e.first = static_cast<uint32_t>(m_candidates.size());
+    for (auto i = m_begin; i != m_end; ++i) {
+      if (is_candidate(*i, e)) {
+        m_candidates.push_back(i);
+      }
+    }
+    e.last = static_cast<uint32_t>(m_candidates.size());
+  }
+  m_dispatch.shrink_to_fit();
+  m_candidates.shrink_to_fit();
+}
+
+behavior_impl::candidate_range
+behavior_impl::candidates(uint32_t type_token, const message& msg) const {
+  auto first = m_dispatch.begin();
+  auto last = m_dispatch.end();
+  dispatch_entry probe{type_token, false, atom_value{}, 0, 0};
+  auto i = std::lower_bound(first, last, probe, entry_less<dispatch_entry>);
+  auto data = m_candidates.data();
+  if (i == last || i->type_token != type_token) {
+    return {data, data + m_num_wildcards};
+  }
+  // entries with leading atom directly follow the plain entry of a token,
+  // the type token alone is not sufficient to tell whether the first
+  // element is an atom, because tokens only store the last few types
+  auto next = i + 1;
+  if (next != last && next->type_token == type_token && !msg.empty()
+      && msg.match_element<atom_value>(0)) {
+    probe.has_atom = true;
+    probe.atom = msg.get_as<atom_value>(0);
+    auto j = std::lower_bound(next, last, probe, entry_less<dispatch_entry>);
+    if (j != last && j->type_token == type_token && j->atom == probe.atom) {
+      return {data + j->first, data + j->last};
+    }
+  }
+  return {data + i->first, data + i->last};
+}
+
 behavior_impl::pointer behavior_impl::or_else(const pointer& other) {
   CAF_ASSERT(other != nullptr);
   return make_counted<combinator>(this, other);
@@ -17,8 +17,6 @@
  * http://www.boost.org/LICENSE_1_0.txt.                                      *
  ******************************************************************************/
 
-#include <iterator>
-
 #include "caf/none.hpp"
 #include "caf/local_actor.hpp"
 #include "caf/detail/behavior_stack.hpp"
@@ -30,16 +28,20 @@ void behavior_stack::pop_back() {
   if (m_elements.empty()) {
     return;
   }
-  m_erased_elements.push_back(std::move(m_elements.back()));
+  auto& x = m_elements.back();
+  if (!x.second) {
+    m_erased_elements.push_back(std::move(x.first));
+  }
   m_elements.pop_back();
 }
 
 void behavior_stack::clear() {
-  if (!m_elements.empty()) {
-    std::move(m_elements.begin(), m_elements.end(),
-              std::back_inserter(m_erased_elements));
-    m_elements.clear();
+  for (auto& x : m_elements) {
+    if (!x.second) {
+      m_erased_elements.push_back(std::move(x.first));
+    }
   }
+  m_elements.clear();
 }
 
 } // namespace detail
@@ -25,22 +25,21 @@ namespace caf {
 
 class binary_writer : public static_visitor<> {
  public:
-  using write_fun = binary_serializer::write_fun;
-
-  binary_writer(write_fun& sink) : m_out(sink) {}
+  binary_writer(binary_serializer& sink) : m_out(sink) {}
 
   template <class T>
-  static inline void write_int(write_fun& f, const T& value) {
+  static inline void write_int(binary_serializer& f, const T& value) {
     auto first = reinterpret_cast<const char*>(&value);
     auto last = first + sizeof(T);
-    f(first, last);
+    f.append(first, last);
   }
 
-  static inline void write_string(write_fun& f, const std::string& str) {
+  static inline void write_string(binary_serializer& f,
+                                  const std::string& str) {
     write_int(f, static_cast<uint32_t>(str.size()));
     auto first = str.data();
     auto last = first + str.size();
-    f(first, last);
+    f.append(first, last);
   }
 
   template <class T>
@@ -91,11 +90,18 @@ class binary_writer : public static_visitor<> {
   }
 
  private:
-  write_fun& m_out;
+  binary_serializer& m_out;
 };
 
+binary_serializer::binary_serializer(buffer_type* buf, actor_namespace* ns)
+    : super(ns),
+      m_buf(buf) {
+  // nop
+}
+
+
 void binary_serializer::begin_object(const uniform_type_info* uti) {
-  binary_writer::write_string(m_out, uti->name());
+  binary_writer::write_string(*this, uti->name());
 }
 
 void binary_serializer::end_object() {
@@ -103,7 +109,7 @@ void binary_serializer::end_object() {
 }
 
 void binary_serializer::begin_sequence(size_t list_size) {
-  binary_writer::write_int(m_out, static_cast<uint32_t>(list_size));
+  binary_writer::write_int(*this, static_cast<uint32_t>(list_size));
 }
 
 void binary_serializer::end_sequence() {
@@ -111,14 +117,18 @@ void binary_serializer::end_sequence() {
 }
 
 void binary_serializer::write_value(const primitive_variant& value) {
-  binary_writer bw{m_out};
+  binary_writer bw{*this};
   apply_visitor(bw, value);
 }
 
 void binary_serializer::write_raw(size_t num_bytes, const void* data) {
   auto first = reinterpret_cast<const char*>(data);
   auto last = first + num_bytes;
-  m_out(first, last);
+  append(first, last);
+}
+
+bool binary_serializer::writes_raw_integers() const {
+  return true;
 }
 
 } // namespace caf
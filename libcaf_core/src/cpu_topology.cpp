@@ -0,0 +1,205 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include <tuple>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include "caf/config.hpp"
+
+#ifdef CAF_LINUX
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+bool read_line(const std::string& path, std::string& line) {
+  std::ifstream in{path};
+  return static_cast<bool>(std::getline(in, line));
+}
+
+int read_int(const std::string& path, int fallback) {
+  std::string line;
+  if (!read_line(path, line)) {
+    return fallback;
+  }
+  std::istringstream iss{line};
+  int result;
+  return iss >> result ? result : fallback;
+}
+
+// parses the sysfs list format, e.g., "0-3,8-11"
+std::vector<int> read_list(const std::string& path) {
+  std::vector<int> result;
+  std::string line;
+  if (!read_line(path, line)) {
+    return result;
+  }
+  std::istringstream iss{line};
+  std::string range;
+  while (std::getline(iss, range, ',')) {
+    int first;
+    int last;
+    char sep;
+    std::istringstream rss{range};
+    if (!(rss >> first)) {
+      continue;
+    }
+    if (!(rss >> sep >> last)) {
+      last = first;
+    }
+    for (auto i = first; i <= last; ++i) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+} // namespace <anonymous>
+
+const cpu_topology& cpu_topology::instance() {
+# ifdef CAF_LINUX
+  static cpu_topology result = read("/sys/devices/system", allowed_cpus());
+# else
+  static cpu_topology result;
+# endif
+  return result;
+}
+
+cpu_topology cpu_topology::read(const std::string& root) {
+  return read(root, std::vector<int>{});
+}
+
+cpu_topology cpu_topology::read(const std::string& root,
+                                const std::vector<int>& allowed) {
+  cpu_topology result;
+  auto& xs = result.m_cpus;
+  for (auto id : read_list(root + "/cpu/online")) {
+    if (!allowed.empty()
+        && std::find(allowed.begin(), allowed.end(), id) == allowed.end()) {
+      // pinning a worker to this CPU would fail
+      continue;
+    }
+    auto dir = root + "/cpu/cpu" + std::to_string(id) + "/topology/";
+    xs.push_back(cpu_info{id, read_int(dir + "core_id", id),
+                          read_int(dir + "physical_package_id", 0), 0});
+  }
+  for (auto node : read_list(root + "/node/online")) {
+    auto path = root + "/node/node" + std::to_string(node) + "/cpulist";
+    for (auto id : read_list(path)) {
+      auto i = std::find_if(xs.begin(), xs.end(),
+                            [=](const cpu_info& x) { return x.id == id; });
+      if (i != xs.end()) {
+        i->node = node;
+      }
+    }
+  }
+  // the n-th logical CPU of a core is its n-th SMT thread
+  auto key = [](const cpu_info& x) {
+    return std::make_tuple(x.node, x.package, x.core, x.id);
+  };
+  std::sort(xs.begin(), xs.end(), [&](const cpu_info& x, const cpu_info& y) {
+    return key(x) < key(y);
+  });
+  std::vector<size_t> smt(xs.size(), 0);
+  for (size_t i = 1; i < xs.size(); ++i) {
+    if (xs[i].package == xs[i - 1].package && xs[i].core == xs[i - 1].core) {
+      smt[i] = smt[i - 1] + 1;
+    }
+  }
+  std::vector<size_t> order(xs.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+    return smt[x] < smt[y];
+  });
+  std::vector<cpu_info> sorted;
+  sorted.reserve(xs.size());
+  for (auto i : order) {
+    sorted.push_back(xs[i]);
+  }
+  xs.swap(sorted);
+  return result;
+}
+
+std::vector<int> cpu_topology::allowed_cpus() {
+  std::vector<int> result;
+# ifdef CAF_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &set) != 0) {
+    return result;
+  }
+  for (int i = 0; i < CPU_SETSIZE; ++i) {
+    if (CPU_ISSET(i, &set)) {
+      result.push_back(i);
+    }
+  }
+# endif
+  return result;
+}
+
+const cpu_info* cpu_topology::placement(size_t id) const {
+  return m_cpus.empty() ? nullptr : &m_cpus[id % m_cpus.size()];
+}
+
+std::vector<std::vector<size_t>>
+cpu_topology::steal_tiers(size_t id, size_t num_workers) const {
+  std::vector<std::vector<size_t>> result(3);
+  auto self = placement(id);
+  for (size_t i = 0; i < num_workers; ++i) {
+    if (i == id) {
+      continue;
+    }
+    auto other = placement(i);
+    if (!self || !other) {
+      result[2].push_back(i);
+    } else if (self->package == other->package && self->core == other->core) {
+      result[0].push_back(i);
+    } else if (self->node == other->node) {
+      result[1].push_back(i);
+    } else {
+      result[2].push_back(i);
+    }
+  }
+  return result;
+}
+
+bool cpu_topology::pin_this_thread(int cpu) {
+# ifdef CAF_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+# else
+  static_cast<void>(cpu);
+  return false;
+# endif
+}
+
+} // namespace detail
+} // namespace caf
@@ -39,6 +39,7 @@ const char* as_string(uint32_t value) {
     return s_names_table[value];
   }
   switch (value) {
+    case mailbox_full: return "mailbox_full";
     case user_shutdown: return "user_shutdown";
     case remote_link_unreachable: return "remote_link_unreachable";
     default:
@@ -32,6 +32,7 @@
 #include "caf/serializer.hpp"
 #include "caf/deserializer.hpp"
 #include "caf/event_based_actor.hpp"
+#include "caf/forwarding_actor_proxy.hpp"
 
 #include "caf/detail/group_manager.hpp"
 
@@ -206,8 +207,32 @@ class local_broker : public event_based_actor {
     CAF_LOG_DEBUG("forward message to " << m_acquaintances.size()
                   << " acquaintances; " << CAF_TSARG(sender) << ", "
                   << CAF_TSARG(what));
+    // remote acquaintances are proxies forwarding to the same manager in
+    // most cases; we hand all of them to their manager at once to have the
+    // message serialized once and sent once per node
+    std::vector<std::pair<actor, std::vector<actor_addr>>> remotes;
     for (auto& acquaintance : m_acquaintances) {
-      acquaintance->enqueue(sender, invalid_message_id, what, host());
+      auto ptr = actor_cast<abstract_actor_ptr>(acquaintance);
+      auto fwd = dynamic_cast<forwarding_actor_proxy*>(ptr.get());
+      auto mgr = fwd ? fwd->manager() : invalid_actor;
+      if (mgr == invalid_actor) {
+        acquaintance->enqueue(sender, invalid_message_id, what, host());
+        continue;
+      }
+      auto i = std::find_if(remotes.begin(), remotes.end(),
+                            [&](const std::pair<actor, std::vector<actor_addr>>&
+                                  x) { return x.first == mgr; });
+      if (i == remotes.end()) {
+        remotes.emplace_back(mgr, std::vector<actor_addr>{});
+        i = remotes.end() - 1;
+      }
+      i->second.push_back(acquaintance.address());
+    }
+    for (auto& kvp : remotes) {
+      kvp.first->enqueue(invalid_actor_addr, invalid_message_id,
+                         make_message(atom("_Multicast"), sender,
+                                      std::move(kvp.second), what),
+                         host());
     }
   }
 
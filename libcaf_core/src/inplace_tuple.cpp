@@ -0,0 +1,174 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/inplace_tuple.hpp"
+
+#include <new>
+#include <vector>
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+
+#include "caf/detail/type_nr.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+constexpr size_t max_alignment = alignof(std::max_align_t);
+
+inline size_t align_to(size_t pos, size_t alignment) {
+  return (pos + alignment - 1) / alignment * alignment;
+}
+
+} // namespace <anonymous>
+
+bool inplace_tuple::supported(types_iterator first, types_iterator last) {
+  return std::all_of(first, last, [](const uniform_type_info* uti) {
+    return uti->instance_size() > 0
+           && uti->instance_alignment() <= max_alignment;
+  });
+}
+
+intrusive_ptr<inplace_tuple> inplace_tuple::make(types_iterator first,
+                                                 types_iterator last) {
+  auto result = allocate(first, last);
+  auto n = result->m_size;
+  result->m_size = 0;
+  try {
+    for (auto e = result->elements(); result->m_size < n; ++e) {
+      e->type->construct(e->value);
+      ++result->m_size;
+    }
+  }
+  catch (...) {
+    // destroys only the elements we have constructed so far
+    result->request_deletion(false);
+    throw;
+  }
+  return {result, false};
+}
+
+void inplace_tuple::request_deletion(bool) noexcept {
+  void* ptr = this;
+  this->~inplace_tuple();
+  ::operator delete(ptr);
+}
+
+void* inplace_tuple::mutable_at(size_t pos) {
+  CAF_ASSERT(pos < size());
+  return elements()[pos].value;
+}
+
+size_t inplace_tuple::size() const {
+  return m_size;
+}
+
+message_data::cow_ptr inplace_tuple::copy() const {
+  std::vector<const uniform_type_info*> types;
+  types.reserve(m_size);
+  for (size_t i = 0; i < m_size; ++i) {
+    types.push_back(elements()[i].type);
+  }
+  auto result = allocate(types.data(), types.data() + types.size());
+  result->m_size = 0;
+  try {
+    for (auto e = result->elements(); result->m_size < m_size; ++e) {
+      e->type->copy_construct(e->value, at(result->m_size));
+      ++result->m_size;
+    }
+  }
+  catch (...) {
+    result->request_deletion(false);
+    throw;
+  }
+  return cow_ptr{result, false};
+}
+
+const void* inplace_tuple::at(size_t pos) const {
+  CAF_ASSERT(pos < size());
+  return elements()[pos].value;
+}
+
+bool inplace_tuple::match_element(size_t pos, uint16_t typenr,
+                                  const std::type_info* rtti) const {
+  CAF_ASSERT(typenr != 0 || rtti != nullptr);
+  auto uti = elements()[pos].type;
+  if (uti->type_nr() != typenr) {
+    return false;
+  }
+  return typenr != 0 || uti->equal_to(*rtti);
+}
+
+uint32_t inplace_tuple::type_token() const {
+  return m_type_token;
+}
+
+const char* inplace_tuple::uniform_name_at(size_t pos) const {
+  CAF_ASSERT(pos < size());
+  return elements()[pos].type->name();
+}
+
+uint16_t inplace_tuple::type_nr_at(size_t pos) const {
+  CAF_ASSERT(pos < size());
+  return elements()[pos].type->type_nr();
+}
+
+inplace_tuple::inplace_tuple(size_t size)
+    : m_size(size),
+      m_type_token(make_type_token()) {
+  // nop
+}
+
+inplace_tuple::~inplace_tuple() {
+  auto e = elements();
+  for (size_t i = 0; i < m_size; ++i) {
+    e[i].type->destroy(e[i].value);
+  }
+}
+
+inplace_tuple* inplace_tuple::allocate(types_iterator first,
+                                       types_iterator last) {
+  CAF_ASSERT(supported(first, last));
+  auto n = static_cast<size_t>(std::distance(first, last));
+  // the element table directly follows the tuple, the values follow the table
+  auto header_size = sizeof(inplace_tuple) + n * sizeof(element);
+  auto total_size = header_size;
+  for (auto i = first; i != last; ++i) {
+    total_size = align_to(total_size, (*i)->instance_alignment())
+                 + (*i)->instance_size();
+  }
+  auto block = static_cast<char*>(::operator new(total_size));
+  auto result = new (block) inplace_tuple(n);
+  auto pos = header_size;
+  auto e = result->elements();
+  for (auto i = first; i != last; ++i, ++e) {
+    pos = align_to(pos, (*i)->instance_alignment());
+    e->type = *i;
+    e->value = block + pos;
+    pos += (*i)->instance_size();
+    result->m_type_token = add_to_type_token(result->m_type_token,
+                                             (*i)->type_nr());
+  }
+  return result;
+}
+
+} // namespace detail
+} // namespace caf
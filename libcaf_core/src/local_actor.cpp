@@ -25,17 +25,39 @@
 #include "caf/local_actor.hpp"
 #include "caf/default_attachable.hpp"
 
+#include "caf/scheduler/thread_pool.hpp"
+
 #include "caf/detail/logging.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
 
 namespace caf {
 
+namespace {
+
+// responses, high-priority messages and system messages
+// bypass mailbox bounds, since discarding them breaks invariants
+bool is_droppable(const mailbox_element& x) {
+  if (x.mid.is_response() || x.mid.is_high_priority()) {
+    return false;
+  }
+  auto& msg = x.msg;
+  return msg.size() != 1
+         || !(msg.match_element<exit_msg>(0)
+              || msg.match_element<down_msg>(0)
+              || msg.match_element<timeout_msg>(0)
+              || msg.match_element<sync_timeout_msg>(0));
+}
+
+} // namespace <anonymous>
+
 // local actors are created with a reference count of one that is adjusted
 // later on in spawn(); this prevents subtle bugs that lead to segfaults,
 // e.g., when calling address() in the ctor of a derived class
 local_actor::local_actor()
     : m_planned_exit_reason(exit_reason::not_exited),
-      m_timeout_id(0) {
+      m_timeout_id(0),
+      m_mailbox_capacity(0),
+      m_mailbox_overflow(mailbox_overflow::drop_newest) {
   // nop
 }
 
@@ -133,18 +155,26 @@ void local_actor::forward_message(const actor& dest, message_priority prio) {
 }
 
 uint32_t local_actor::request_timeout(const duration& d) {
+  // the previous timeout becomes obsolete in any case
+  cancel_timeout();
   if (!d.valid()) {
     has_timeout(false);
     return 0;
   }
   has_timeout(true);
   auto result = ++m_timeout_id;
-  auto msg = make_message(timeout_msg{++m_timeout_id});
   if (d.is_zero()) {
     // immediately enqueue timeout message if duration == 0s
-    enqueue(address(), invalid_message_id, std::move(msg), host());
+    enqueue(mailbox_element::make_joint(address(), invalid_message_id,
+                                        timeout_msg{result}),
+            host());
   } else {
-    delayed_send(this, d, std::move(msg));
+    auto sched_cd = detail::singletons::get_scheduling_coordinator();
+    m_timeout_handle =
+      sched_cd->delayed_send(d, this,
+                             mailbox_element::make_joint(address(),
+                                                         message_id::make(),
+                                                         timeout_msg{result}));
   }
   return result;
 }
@@ -153,6 +183,8 @@ void local_actor::handle_timeout(behavior& bhvr, uint32_t timeout_id) {
   if (!is_active_timeout(timeout_id)) {
     return;
   }
+  // the timer service has delivered the message already
+  m_timeout_handle.reset();
   bhvr.handle_timeout();
   if (m_bhvr_stack.empty() || m_bhvr_stack.back() != bhvr) {
     return;
@@ -174,6 +206,15 @@ void local_actor::handle_timeout(behavior& bhvr, uint32_t timeout_id) {
 void local_actor::reset_timeout(uint32_t timeout_id) {
   if (is_active_timeout(timeout_id)) {
     has_timeout(false);
+    cancel_timeout();
+  }
+}
+
+void local_actor::cancel_timeout() {
+  if (m_timeout_handle) {
+    auto sched_cd = detail::singletons::get_scheduling_coordinator();
+    sched_cd->timers().cancel(m_timeout_handle);
+    m_timeout_handle.reset();
   }
 }
 
@@ -387,20 +428,6 @@ invoke_message_result local_actor::invoke_message(mailbox_element_ptr& ptr,
   CAF_CRITICAL("invalid message type");
 }
 
-struct pending_response_predicate {
- public:
-  pending_response_predicate(message_id mid) : m_mid(mid) {
-    // nop
-  }
-
-  bool operator()(const local_actor::pending_response& pr) const {
-    return std::get<0>(pr) == m_mid;
-  }
-
- private:
-  message_id m_mid;
-};
-
 message_id local_actor::new_request_id(message_priority mp) {
   auto result = ++m_last_request_id;
   m_pending_responses.push_front(std::make_pair(result.response_id(),
@@ -410,8 +437,7 @@ message_id local_actor::new_request_id(message_priority mp) {
 
 void local_actor::mark_arrived(message_id mid) {
   CAF_ASSERT(mid.is_response());
-  pending_response_predicate predicate{mid};
-  m_pending_responses.remove_if(predicate);
+  m_pending_responses.erase(mid);
 }
 
 bool local_actor::awaits_response() const {
@@ -420,20 +446,16 @@ bool local_actor::awaits_response() const {
 
 bool local_actor::awaits(message_id mid) const {
   CAF_ASSERT(mid.is_response());
-  pending_response_predicate predicate{mid};
-  return std::any_of(m_pending_responses.begin(), m_pending_responses.end(),
-                     predicate);
+  return m_pending_responses.find(mid) != nullptr;
 }
 
 optional<local_actor::pending_response&>
 local_actor::find_pending_response(message_id mid) {
-  pending_response_predicate predicate{mid};
-  auto last = m_pending_responses.end();
-  auto i = std::find_if(m_pending_responses.begin(), last, predicate);
-  if (i == last) {
+  auto ptr = m_pending_responses.find(mid);
+  if (!ptr) {
     return none;
   }
-  return *i;
+  return *ptr;
 }
 
 void local_actor::set_response_handler(message_id response_id, behavior bhvr) {
@@ -456,12 +478,12 @@ message_id local_actor::awaited_response_id() {
 void local_actor::launch(execution_unit* eu, bool lazy, bool hide) {
   is_registered(!hide);
   if (is_detached()) {
-    // actor lives in its own thread
+    // actor runs in a thread of the blocking pool until it is done
     CAF_PUSH_AID(id());
     CAF_LOG_TRACE(CAF_ARG(lazy) << ", " << CAF_ARG(hide));
     intrusive_ptr<local_actor> mself{this};
     attach_to_scheduler();
-    std::thread([=] {
+    detail::singletons::get_blocking_pool()->run([=] {
       CAF_PUSH_AID(id());
       CAF_LOG_TRACE("");
       auto max_throughput = std::numeric_limits<size_t>::max();
@@ -471,7 +493,7 @@ void local_actor::launch(execution_unit* eu, bool lazy, bool hide) {
         CAF_ASSERT(mailbox().blocked() == false);
       }
       detach_from_scheduler();
-    }).detach();
+    });
     return;
   }
   // actor is cooperatively scheduled
@@ -493,14 +515,22 @@ void local_actor::enqueue(const actor_addr& sender, message_id mid,
 }
 
 void local_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
+  if (exceeds_mailbox_bounds(*ptr)) {
+    drop_message(std::move(ptr), eu);
+    return;
+  }
+  // priority-aware actors use a separate lane for high priority messages
+  auto high = is_priority_aware() && ptr->is_high_priority();
   if (is_detached()) {
     // actor lives in its own thread
     auto mid = ptr->mid;
     auto sender = ptr->sender;
     // returns false if mailbox has been closed
-    if (!mailbox().synchronized_enqueue(m_mtx,
-                                              m_cv,
-                                              ptr.release())) {
+    auto ok = high ? mailbox().synchronized_enqueue_high(m_mtx, m_cv,
+                                                         ptr.release())
+                   : mailbox().synchronized_enqueue(m_mtx, m_cv,
+                                                    ptr.release());
+    if (!ok) {
       if (mid.is_request()) {
         detail::sync_request_bouncer srb{exit_reason()};
         srb(sender, mid);
@@ -511,7 +541,9 @@ void local_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   // actor is cooperatively scheduled
   auto mid = ptr->mid;
   auto sender = ptr->sender;
-  switch (mailbox().enqueue(ptr.release())) {
+  auto res = high ? mailbox().enqueue_high(ptr.release())
+                  : mailbox().enqueue(ptr.release());
+  switch (res) {
     case detail::enqueue_result::unblocked_reader: {
       // re-schedule actor
       if (eu) {
@@ -534,6 +566,49 @@ void local_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   }
 }
 
+void local_actor::enqueue_batch(mailbox_batch batch, execution_unit* eu) {
+  if (batch.empty()) {
+    return;
+  }
+  if (m_mailbox_capacity > 0 || is_priority_aware()) {
+    // check bounds or select the lane for each element individually
+    abstract_channel::enqueue_batch(std::move(batch), eu);
+    return;
+  }
+  auto first = batch.release();
+  auto res = is_detached()
+             ? mailbox().synchronized_enqueue_batch(m_mtx, m_cv, first)
+             : mailbox().enqueue_batch(first);
+  switch (res) {
+    case detail::enqueue_result::unblocked_reader: {
+      if (is_detached()) {
+        // actor lives in its own thread and has been notified already
+        break;
+      }
+      // re-schedule actor once for the whole batch
+      if (eu) {
+        eu->exec_later(this);
+      } else {
+        detail::singletons::get_scheduling_coordinator()->enqueue(this);
+      }
+      break;
+    }
+    case detail::enqueue_result::queue_closed: {
+      // we still own all elements if the mailbox has been closed
+      batch.reset(first);
+      detail::sync_request_bouncer f{exit_reason()};
+      for (auto i = batch.front(); i != nullptr; i = i->next) {
+        if (i->mid.is_request()) {
+          f(i->sender, i->mid);
+        }
+      }
+      break;
+    }
+    case detail::enqueue_result::success:
+      break;
+  }
+}
+
 void local_actor::attach_to_scheduler() {
   ref();
 }
@@ -582,6 +657,8 @@ resumable::resume_result local_actor::resume(execution_unit* eu,
     CAF_LOG_TRACE("");
     bhvr_stack().clear();
     bhvr_stack().cleanup();
+    // an exiting actor no longer awaits any response
+    m_pending_responses.clear();
     on_exit();
     if (has_behavior()) {
       CAF_LOG_DEBUG("on_exit did set a new behavior");
@@ -713,47 +790,69 @@ resumable::resume_result local_actor::resume(execution_unit* eu,
   return resumable::done;
 }
 
-mailbox_element_ptr local_actor::next_message() {
-  if (!is_priority_aware()) {
-    return mailbox_element_ptr{mailbox().try_pop()};
+bool local_actor::exceeds_mailbox_bounds(const mailbox_element& x) const {
+  if (m_mailbox_capacity == 0 || !is_droppable(x)) {
+    return false;
   }
-  // we partition the mailbox into four segments in this case:
-  // <-------- !was_skipped --------> | <--------  was_skipped -------->
-  // <-- high prio --><-- low prio -->|<-- high prio --><-- low prio -->
-  auto& cache = mailbox().cache();
-  auto i = cache.first_begin();
-  auto e = cache.first_end();
-  if (i == e || !i->is_high_priority()) {
-    // insert points for high priority
-    auto hp_pos = i;
-    // read whole mailbox at once
-    auto tmp = mailbox().try_pop();
-    while (tmp) {
-      cache.insert(tmp->is_high_priority() ? hp_pos : e, tmp);
-      // adjust high priority insert point on first low prio element insert
-      if (hp_pos == e && !tmp->is_high_priority()) {
-        --hp_pos;
+  if (m_mailbox_overflow == mailbox_overflow::drop_oldest) {
+    // only the reader can discard the oldest messages, but we still need
+    // a hard limit for writers to keep memory bounded if the reader
+    // falls behind; the reader trims the mailbox back to its capacity
+    return m_mailbox.size() >= 2 * m_mailbox_capacity;
+  }
+  return m_mailbox.size() >= m_mailbox_capacity;
+}
+
+void local_actor::drop_message(mailbox_element_ptr x, execution_unit* eu) {
+  CAF_LOG_DEBUG("mailbox full, drop message");
+  switch (m_mailbox_overflow) {
+    case mailbox_overflow::drop_newest:
+    case mailbox_overflow::drop_oldest:
+      break;
+    case mailbox_overflow::reject_requests:
+    case mailbox_overflow::notify_sender:
+      if (x->mid.is_request()) {
+        detail::sync_request_bouncer f{exit_reason::mailbox_full};
+        f(*x);
+      } else if (m_mailbox_overflow == mailbox_overflow::notify_sender
+                 && x->sender
+                 // never notify a sender about a discarded notification
+                 && !(x->msg.match_elements<atom_value>()
+                      && x->msg.get_as<atom_value>(0)
+                         == mailbox_full_atom::value)) {
+        auto ptr = actor_cast<abstract_actor_ptr>(x->sender);
+        ptr->enqueue(address(), invalid_message_id,
+                     make_message(mailbox_full_atom::value), eu);
       }
-      tmp = mailbox().try_pop();
-    }
+      break;
   }
-  mailbox_element_ptr result;
-  if (!cache.first_empty()) {
-    result.reset(cache.take_first_front());
+}
+
+mailbox_element_ptr local_actor::next_message() {
+  // returns true if `x` is older than the most recent `m_mailbox_capacity`
+  // messages and thus needs to be discarded with policy drop_oldest
+  auto is_stale = [&](const mailbox_element* x) {
+    return m_mailbox_capacity > 0
+           && m_mailbox_overflow == mailbox_overflow::drop_oldest
+           && m_mailbox.size() >= m_mailbox_capacity
+           && is_droppable(*x);
+  };
+  // the mailbox returns high priority messages of priority-aware
+  // actors first, since they use a separate lane
+  mailbox_element_ptr result{mailbox().try_pop()};
+  while (result && is_stale(result.get())) {
+    drop_message(std::move(result), host());
+    result.reset(mailbox().try_pop());
   }
   return result;
 }
 
 bool local_actor::has_next_message() {
-  if (!is_priority_aware()) {
-    return m_mailbox.can_fetch_more();
-  }
-  auto& mbox = mailbox();
-  auto& cache = mbox.cache();
-  return !cache.first_empty() || mbox.can_fetch_more();
+  return m_mailbox.can_fetch_more();
 }
 
 void local_actor::push_to_cache(mailbox_element_ptr ptr) {
+  m_stash.add(*ptr);
   if (!is_priority_aware()) {
     mailbox().cache().push_second_back(ptr.release());
     return;
@@ -774,11 +873,22 @@ bool local_actor::invoke_from_cache() {
 }
 
 bool local_actor::invoke_from_cache(behavior& bhvr, message_id mid) {
+  if (m_stash.size() == 0) {
+    return false;
+  }
+  detail::stash_index::scan filter{m_stash, bhvr, mid, trap_exit()};
+  if (!filter.needed()) {
+    return false;
+  }
   auto& cache = mailbox().cache();
   auto i = cache.second_begin();
   auto e = cache.second_end();
-  CAF_LOG_DEBUG(std::distance(i, e) << " elements in cache");
-  return cache.invoke(this, i, e, bhvr, mid);
+  CAF_LOG_DEBUG(m_stash.size() << " elements in cache");
+  if (cache.invoke(this, i, e, bhvr, mid, filter)) {
+    return true;
+  }
+  filter.completed();
+  return false;
 }
 
 void local_actor::do_become(behavior bhvr, bool discard_old) {
@@ -790,6 +900,14 @@ void local_actor::do_become(behavior bhvr, bool discard_old) {
   m_bhvr_stack.push_back(std::move(bhvr));
 }
 
+void local_actor::do_become_ref(behavior& bhvr, bool discard_old) {
+  if (discard_old) {
+    m_bhvr_stack.pop_back();
+  }
+  request_timeout(bhvr.timeout());
+  m_bhvr_stack.push_back_ref(bhvr);
+}
+
 void local_actor::await_data() {
   if (has_next_message()) {
     return;
@@ -816,6 +934,13 @@ void local_actor::delayed_send_impl(message_id mid, const channel& dest,
   sched_cd->delayed_send(rel_time, address(), dest, mid, std::move(msg));
 }
 
+void local_actor::delayed_send_impl(const channel& dest,
+                                    const duration& rel_time,
+                                    mailbox_element_ptr what) {
+  auto sched_cd = detail::singletons::get_scheduling_coordinator();
+  sched_cd->delayed_send(rel_time, dest, std::move(what));
+}
+
 response_promise local_actor::make_response_promise() {
   auto& ptr = m_current_element;
   if (!ptr) {
@@ -828,8 +953,11 @@ response_promise local_actor::make_response_promise() {
 
 void local_actor::cleanup(uint32_t reason) {
   CAF_LOG_TRACE(CAF_ARG(reason));
+  // a pending timeout would keep this actor alive until it fires
+  cancel_timeout();
   detail::sync_request_bouncer f{reason};
   m_mailbox.close(f);
+  m_stash.clear();
   abstract_actor::cleanup(reason);
   // tell registry we're done
   is_registered(false);
@@ -18,11 +18,21 @@
  ******************************************************************************/
 
 #include <ctime>
+#include <limits>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
 #include <thread>
+#include <vector>
 #include <cstring>
 #include <fstream>
+#include <iterator>
 #include <algorithm>
+#include <streambuf>
 #include <pthread.h>
+#include <unordered_map>
 #include <condition_variable>
 
 #ifndef CAF_WINDOWS
@@ -43,41 +53,190 @@
 #include "caf/actor_proxy.hpp"
 
 #include "caf/detail/logging.hpp"
-#include "caf/detail/single_reader_queue.hpp"
 
 namespace caf {
 namespace detail {
 
 namespace {
 
-constexpr struct pop_aid_log_event_t {
-  constexpr pop_aid_log_event_t() {
+#ifndef CAF_LOG_LEVEL
+  constexpr int global_log_level = 0;
+#else
+  constexpr int global_log_level = CAF_LOG_LEVEL;
+#endif
+
+// appends everything written to the stream to a string
+class string_sink : public std::streambuf {
+ public:
+  explicit string_sink(std::string* str) : m_str(str) {
     // nop
   }
-} pop_aid_log_event;
 
-struct log_event {
-  log_event* next;
-  log_event* prev;
+ protected:
+  int_type overflow(int_type c) override {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      m_str->push_back(traits_type::to_char_type(c));
+    }
+    return traits_type::not_eof(c);
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize n) override {
+    m_str->append(s, static_cast<size_t>(n));
+    return n;
+  }
+
+ private:
+  std::string* m_str;
+};
+
+// the format of a stream without any manipulator
+const std::ios_base::fmtflags default_flags = std::ios_base::dec
+                                              | std::ios_base::skipws
+                                              | std::ios_base::boolalpha;
+
+constexpr std::streamsize default_precision = 6;
+
+class string_ostream : public std::ostream {
+ public:
+  explicit string_ostream(std::string* str) : std::ostream(nullptr),
+                                              m_sink(str) {
+    rdbuf(&m_sink);
+    reset();
+  }
+
+  // undoes any manipulator applied by a previous message
+  void reset() {
+    clear();
+    flags(default_flags);
+    precision(default_precision);
+    width(0);
+    fill(' ');
+  }
+
+ private:
+  string_sink m_sink;
+};
+
+// the message buffer of a thread, reused by each oss_wr
+struct oss_buffer {
+  std::string str;
+  std::unique_ptr<string_ostream> out;
+  bool in_use = false;
+};
+
+oss_buffer& local_oss_buffer() {
+  thread_local oss_buffer result;
+  return result;
+}
+
+// a fixed-size record written by the logging thread; all strings except
+// `msg` have static storage duration, i.e., we store pointers only
+struct log_record {
+  const char* level;
+  const char* class_name;
+  const char* function_name;
+  const char* file_name;
+  int line_num;
+  actor_id aid;
+  std::thread::id tid;
+  std::chrono::steady_clock::time_point timestamp;
   std::string msg;
-  log_event(std::string logmsg = "")
-      : next(nullptr),
-        prev(nullptr),
-        msg(std::move(logmsg)) {
+};
+
+using steady_rep = std::chrono::steady_clock::rep;
+
+constexpr steady_rep no_pending_record = std::numeric_limits<steady_rep>::max();
+
+// a lock-free single-producer, single-consumer ring buffer
+// owned by exactly one logging thread
+class log_ring {
+ public:
+  static constexpr size_t capacity = 1024; // must be a power of two
+
+  log_ring()
+      : m_orphaned(false),
+        m_pending(no_pending_record),
+        m_head(0),
+        m_tail(0),
+        m_slots(capacity) {
     // nop
   }
+
+  // called by the owning thread only; copies `msg` into the string
+  // of the slot to reuse its memory
+  bool push(log_record& x, const std::string& msg) {
+    auto head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) == capacity) {
+      return false;
+    }
+    auto& slot = m_slots[head & (capacity - 1)];
+    x.msg.swap(slot.msg);
+    slot = std::move(x);
+    slot.msg.assign(msg);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // called by the writer thread only; copies records to keep the memory
+  // of their strings in the slots
+  template <class Container>
+  size_t drain(Container& storage) {
+    auto tail = m_tail.load(std::memory_order_relaxed);
+    auto head = m_head.load(std::memory_order_acquire);
+    for (auto i = tail; i != head; ++i) {
+      storage.push_back(m_slots[i & (capacity - 1)]);
+    }
+    m_tail.store(head, std::memory_order_release);
+    return head - tail;
+  }
+
+  size_t size() const {
+    return m_head.load(std::memory_order_acquire)
+           - m_tail.load(std::memory_order_acquire);
+  }
+
+  // set by the owning thread on exit
+  std::atomic<bool> m_orphaned;
+
+  // a lower bound for the timestamp of the record the owning thread is
+  // about to push or `no_pending_record`
+  std::atomic<steady_rep> m_pending;
+
+ private:
+  std::atomic<size_t> m_head;
+  std::atomic<size_t> m_tail;
+  std::vector<log_record> m_slots;
 };
 
-#ifndef CAF_LOG_LEVEL
-  constexpr int global_log_level = 0;
-#else
-  constexpr int global_log_level = CAF_LOG_LEVEL;
-#endif
+using log_ring_ptr = std::shared_ptr<log_ring>;
+
+// incremented for each logger instance to detect stale thread-local rings
+std::atomic<size_t> s_logger_generation;
+
+struct log_ring_handle {
+  size_t generation = 0;
+  log_ring_ptr ring;
+
+  ~log_ring_handle() {
+    if (ring) {
+      ring->m_orphaned = true;
+    }
+  }
+};
 
 class logging_impl : public logging {
  public:
+  logging_impl()
+      : m_generation(++s_logger_generation),
+        m_running(false),
+        m_system_start(std::chrono::system_clock::now()),
+        m_steady_start(std::chrono::steady_clock::now()) {
+    // nop
+  }
+
   void initialize() override {
     const char* log_level_table[] = {"ERROR", "WARN", "INFO", "DEBUG", "TRACE"};
+    m_running = true;
     m_thread = std::thread([this] { (*this)(); });
     std::string msg = "ENTRY log level = ";
     msg += log_level_table[global_log_level];
@@ -86,8 +245,11 @@ class logging_impl : public logging {
 
   void stop() override {
     log("TRACE", "logging", "run", __FILE__, __LINE__, "EXIT");
-    // an empty string means: shut down
-    m_queue.synchronized_enqueue(m_queue_mtx, m_queue_cv, new log_event{""});
+    m_running = false;
+    { // lifetime scope of guard
+      std::unique_lock<std::mutex> guard{m_mtx};
+      m_cv.notify_one();
+    }
     m_thread.join();
   }
 
@@ -95,24 +257,120 @@ class logging_impl : public logging {
     std::ostringstream fname;
     fname << "actor_log_" << getpid() << "_" << time(0) << ".log";
     std::fstream out(fname.str().c_str(), std::ios::out | std::ios::app);
-    std::unique_ptr<log_event> event;
+    std::vector<log_ring_ptr> rings;
+    // records drained but not yet written, sorted by timestamp
+    std::vector<log_record> batch;
+    std::string buf;
     for (;;) {
-      // make sure we have data to read
-      m_queue.synchronized_await(m_queue_mtx, m_queue_cv);
-      // read & process event
-      event.reset(m_queue.try_pop());
-      CAF_ASSERT(event != nullptr);
-      if (event->msg.empty()) {
-        out.close();
-        return;
+      auto done = !m_running;
+      { // lifetime scope of guard
+        std::unique_lock<std::mutex> guard{m_mtx};
+        // drop rings of terminated threads after draining them
+        auto orphaned = [](const log_ring_ptr& x) {
+          return x->m_orphaned && x->size() == 0;
+        };
+        m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), orphaned),
+                      m_rings.end());
+        rings = m_rings;
+      }
+      // records pushed after draining a ring cannot have a smaller
+      // timestamp than `watermark`, because logging threads publish a
+      // lower bound for their timestamp before taking it
+      auto watermark = std::chrono::steady_clock::now().time_since_epoch()
+                                                        .count();
+      for (auto& ring : rings) {
+        watermark = std::min(watermark, ring->m_pending.load());
+      }
+      auto num_held = batch.size();
+      for (auto& ring : rings) {
+        ring->drain(batch);
+      }
+      if (batch.empty()) {
+        if (done) {
+          return;
+        }
+        std::unique_lock<std::mutex> guard{m_mtx};
+        m_cv.wait_for(guard, std::chrono::milliseconds(10));
+        continue;
+      }
+      // restore the global order of events from all threads; records held
+      // back from the previous batch are already sorted
+      auto by_timestamp = [](const log_record& x, const log_record& y) {
+        return x.timestamp < y.timestamp;
+      };
+      auto held_end = batch.begin() + static_cast<ptrdiff_t>(num_held);
+      std::stable_sort(held_end, batch.end(), by_timestamp);
+      std::inplace_merge(batch.begin(), held_end, batch.end(), by_timestamp);
+      // write only records that no record pushed later can precede
+      auto writable = [&](const log_record& x) {
+        return done || x.timestamp.time_since_epoch().count() < watermark;
+      };
+      auto last = std::partition_point(batch.begin(), batch.end(), writable);
+      if (last == batch.begin()) {
+        std::unique_lock<std::mutex> guard{m_mtx};
+        m_cv.wait_for(guard, std::chrono::milliseconds(1));
+        continue;
+      }
+      for (auto i = batch.begin(); i != last; ++i) {
+        format(buf, *i);
       }
-      out << event->msg << std::flush;
+      out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+      out.flush();
+      buf.clear();
+      batch.erase(batch.begin(), last);
     }
   }
 
-  void log(const char* level, const char* c_class_name,
-           const char* function_name, const char* c_full_file_name,
+  void log(const char* level, const char* class_name,
+           const char* function_name, const char* file_name,
            int line_num, const std::string& msg) override {
+    if (!m_running) {
+      return;
+    }
+    auto ring = local_ring();
+    if (!ring) {
+      return;
+    }
+    // publish a lower bound for our timestamp before taking it, allowing
+    // the writer to tell which records it can safely write
+    ring->m_pending = std::chrono::steady_clock::now().time_since_epoch()
+                                                      .count();
+    log_record x{level, class_name, function_name, file_name, line_num,
+                 get_aid(), std::this_thread::get_id(),
+                 std::chrono::steady_clock::now(), std::string{}};
+    while (!ring->push(x, msg)) {
+      // wake up the writer and wait until it drained our ring
+      m_cv.notify_one();
+      std::this_thread::yield();
+      if (!m_running) {
+        break;
+      }
+    }
+    ring->m_pending = no_pending_record;
+  }
+
+ private:
+  log_ring_ptr local_ring() {
+    thread_local log_ring_handle handle;
+    if (handle.generation != m_generation || !handle.ring) {
+      if (handle.ring) {
+        // ring belongs to a previous logger instance
+        handle.ring->m_orphaned = true;
+      }
+      handle.ring = std::make_shared<log_ring>();
+      handle.generation = m_generation;
+      std::unique_lock<std::mutex> guard{m_mtx};
+      m_rings.push_back(handle.ring);
+    }
+    return handle.ring;
+  }
+
+  // demangles type names once per type and hides CAF magic in logs
+  const std::string& class_name(const char* c_class_name) {
+    auto i = m_class_names.find(c_class_name);
+    if (i != m_class_names.end()) {
+      return i->second;
+    }
 #   if defined(CAF_LINUX) || defined(CAF_MACOS)
     int stat = 0;
     std::unique_ptr<char, decltype(free)*> real_class_name{nullptr, free};
@@ -123,7 +381,6 @@ class logging_impl : public logging {
     replace_all(class_name, "::", ".");
     replace_all(class_name, "(anonymousnamespace)", "$anon$");
     real_class_name.reset();
-    // hide CAF magic in logs
     auto strip_magic = [&](const char* prefix_begin, const char* prefix_end) {
       auto last = class_name.end();
       auto i = std::search(class_name.begin(), last, prefix_begin, prefix_end);
@@ -139,50 +396,54 @@ class logging_impl : public logging {
 #   else
     std::string class_name = c_class_name;
 #   endif
-    std::string file_name;
-    std::string full_file_name = c_full_file_name;
-    auto ri = find(full_file_name.rbegin(), full_file_name.rend(), '/');
-    if (ri != full_file_name.rend()) {
-      auto i = ri.base();
-      if (i == full_file_name.end()) {
-        file_name = std::move(full_file_name);
-      } else {
-        file_name = std::string(i, full_file_name.end());
-      }
-    } else {
-      file_name = std::move(full_file_name);
-    }
+    return m_class_names.emplace(c_class_name, std::move(class_name))
+           .first->second;
+  }
+
+  void format(std::string& buf, const log_record& x) {
+    auto file_name = strrchr(x.file_name, '/');
+    file_name = file_name ? file_name + 1 : x.file_name;
+    auto timestamp = m_system_start
+                     + std::chrono::duration_cast<
+                         std::chrono::system_clock::duration>(
+                         x.timestamp - m_steady_start);
     std::ostringstream line;
-    line << time(0) << " " << level << " "
-         << "actor" << get_aid() << " " << std::this_thread::get_id() << " "
-         << class_name << " " << function_name << " " << file_name << ":"
-         << line_num << " " << msg << std::endl;
-    m_queue.synchronized_enqueue(m_queue_mtx, m_queue_cv,
-                                 new log_event{line.str()});
+    line << std::chrono::system_clock::to_time_t(timestamp) << " "
+         << x.level << " " << "actor" << x.aid << " " << x.tid << " "
+         << class_name(x.class_name) << " " << x.function_name << " "
+         << file_name << ":" << x.line_num << " " << x.msg << "\n";
+    buf += line.str();
   }
 
- private:
+  size_t m_generation;
+  std::atomic<bool> m_running;
+  // maps the steady timestamps of records to wall-clock time
+  std::chrono::system_clock::time_point m_system_start;
+  std::chrono::steady_clock::time_point m_steady_start;
   std::thread m_thread;
-  std::mutex m_queue_mtx;
-  std::condition_variable m_queue_cv;
-  detail::single_reader_queue<log_event> m_queue;
+  // protects `m_rings` and is used for waking up the writer
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+  std::vector<log_ring_ptr> m_rings;
+  // accessed by the writer thread only
+  std::unordered_map<const char*, std::string> m_class_names;
 };
 
 } // namespace <anonymous>
 
-logging::trace_helper::trace_helper(std::string class_name,
+logging::trace_helper::trace_helper(const char* class_name,
                                     const char* fun_name, const char* file_name,
                                     int line_num, const std::string& msg)
-    : m_class(std::move(class_name)),
+    : m_class(class_name),
       m_fun_name(fun_name),
       m_file_name(file_name),
       m_line_num(line_num) {
-  singletons::get_logger()->log("TRACE", m_class.c_str(), fun_name, file_name,
-                                line_num, "ENTRY " + msg);
+  singletons::get_logger()->log("TRACE", m_class, fun_name, file_name,
+                                line_num, msg);
 }
 
 logging::trace_helper::~trace_helper() {
-  singletons::get_logger()->log("TRACE", m_class.c_str(), m_fun_name,
+  singletons::get_logger()->log("TRACE", m_class, m_fun_name,
                                 m_file_name, m_line_num, "EXIT");
 }
 
@@ -190,6 +451,75 @@ logging::~logging() {
   // nop
 }
 
+oss_wr::oss_wr() : m_formatted(false) {
+  auto& buf = local_oss_buffer();
+  m_shared = !buf.in_use;
+  if (m_shared) {
+    buf.in_use = true;
+    buf.str.clear();
+    if (buf.out) {
+      buf.out->reset();
+    }
+    m_str = &buf.str;
+  } else {
+    m_str = &m_fallback;
+  }
+}
+
+oss_wr::~oss_wr() {
+  if (m_shared) {
+    local_oss_buffer().in_use = false;
+  }
+}
+
+void oss_wr::append_int(long long x) {
+  if (x < 0) {
+    m_str->push_back('-');
+    append_uint(0ULL - static_cast<unsigned long long>(x));
+    return;
+  }
+  append_uint(static_cast<unsigned long long>(x));
+}
+
+void oss_wr::append_uint(unsigned long long x) {
+  char buf[24];
+  auto first = std::end(buf);
+  do {
+    *--first = static_cast<char>('0' + x % 10);
+    x /= 10;
+  } while (x != 0);
+  m_str->append(first, std::end(buf));
+}
+
+void oss_wr::append_double(double x) {
+  // same format as an ostream with default flags
+  char buf[32];
+  auto n = snprintf(buf, sizeof(buf), "%g", x);
+  if (n > 0) {
+    m_str->append(buf, std::min(static_cast<size_t>(n), sizeof(buf) - 1));
+  }
+}
+
+bool oss_wr::has_default_format() {
+  auto& out = stream();
+  return out.flags() == default_flags && out.precision() == default_precision
+         && out.width() == 0;
+}
+
+std::ostream& oss_wr::stream() {
+  if (m_shared) {
+    auto& buf = local_oss_buffer();
+    if (!buf.out) {
+      buf.out.reset(new string_ostream(&buf.str));
+    }
+    return *buf.out;
+  }
+  if (!m_fallback_stream) {
+    m_fallback_stream.reset(new string_ostream(&m_fallback));
+  }
+  return *m_fallback_stream;
+}
+
 logging* logging::create_singleton() {
   return new logging_impl;
 }
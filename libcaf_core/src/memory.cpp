@@ -19,10 +19,11 @@
 
 #include "caf/detail/memory.hpp"
 
+#include <mutex>
+#include <atomic>
 #include <vector>
-#include <typeinfo>
-
-#include "caf/mailbox_element.hpp"
+#include <cstdint>
+#include <algorithm>
 
 #ifdef CAF_NO_MEM_MANAGEMENT
 
@@ -39,51 +40,336 @@ namespace detail {
 
 namespace {
 
-pthread_key_t s_key;
-pthread_once_t s_key_once = PTHREAD_ONCE_INIT;
+constexpr size_t s_cache_size = 10 * 1024 * 1024; // cache about 10mb per thread
+constexpr size_t s_granularity = 32;   // size classes are multiples of 32b
+constexpr size_t s_size_classes = 64;  // cache blocks of up to 2kb
+constexpr size_t s_max_type_ids = 256; // types with larger IDs share slot 0
+constexpr size_t s_batch_size = 32;    // blocks per cross-thread release
 
-} // namespace <anonymous>
+class thread_cache;
+
+// Prefixes each block and serves as ref-counted storage of the object
+// that follows, i.e., the block is released once the object is destroyed.
+class memory_slot : public ref_counted {
+ public:
+  memory_slot(thread_cache* owner, uint32_t size_class, uint32_t type_id)
+      : m_owner(owner),
+        m_size_class(size_class),
+        m_type_id(type_id) {
+    // nop
+  }
+
+  void request_deletion(bool) noexcept override;
+
+ private:
+  thread_cache* m_owner;
+  uint32_t m_size_class;
+  uint32_t m_type_id;
+};
+
+constexpr size_t s_max_align = alignof(std::max_align_t);
+
+constexpr size_t s_header_size =
+  (sizeof(memory_slot) + s_max_align - 1) / s_max_align * s_max_align;
 
-memory_cache::~memory_cache() {
-  // nop
+// Overlays a block that is no longer in use.
+struct free_block {
+  free_block* next;
+  uint32_t size_class;
+  uint32_t type_id;
+};
+
+inline size_t block_size(size_t size_class) {
+  return size_class * s_granularity;
 }
 
-using cache_map = std::map<const std::type_info*,std::unique_ptr<memory_cache>>;
+inline size_t stats_index(size_t type_id) {
+  return type_id < s_max_type_ids ? type_id : 0;
+}
 
-void cache_map_destructor(void* ptr) {
-  delete reinterpret_cast<cache_map*>(ptr);
+// Counters are written only by the thread currently using a cache, but
+// read by any thread collecting statistics.
+inline void add(std::atomic<size_t>& x, size_t y) {
+  x.store(x.load(std::memory_order_relaxed) + y, std::memory_order_relaxed);
 }
 
-void make_cache_map() {
-  pthread_key_create(&s_key, cache_map_destructor);
+inline void sub(std::atomic<size_t>& x, size_t y) {
+  x.store(x.load(std::memory_order_relaxed) - y, std::memory_order_relaxed);
 }
 
-cache_map& get_cache_map() {
-  pthread_once(&s_key_once, make_cache_map);
-  auto cache = reinterpret_cast<cache_map*>(pthread_getspecific(s_key));
-  if (!cache) {
-    cache = new cache_map;
-    pthread_setspecific(s_key, cache);
-    // insert default types
-    std::unique_ptr<memory_cache> tmp(new basic_memory_cache<mailbox_element>);
-    cache->insert(std::make_pair(&typeid(mailbox_element), move(tmp)));
-  }
-  return *cache;
+class thread_cache {
+ public:
+  thread_cache()
+      : m_remote(nullptr),
+        m_retained(0),
+        m_pending_owner(nullptr),
+        m_pending_first(nullptr),
+        m_pending_last(nullptr),
+        m_pending_size(0) {
+    for (auto& x : m_free) {
+      x = nullptr;
+    }
+    for (auto& x : m_retained_by_class) {
+      x = 0;
+    }
+    for (auto& x : m_live) {
+      x = 0;
+    }
+  }
+
+  void* allocate(size_t size_class, size_t type_id) {
+    add_live(type_id);
+    auto& head = m_free[size_class];
+    if (!head) {
+      collect_remote();
+    }
+    if (head) {
+      auto blk = head;
+      head = blk->next;
+      m_retained -= block_size(size_class);
+      sub(m_retained_by_class[size_class], block_size(size_class));
+      return blk;
+    }
+    return ::operator new(block_size(size_class));
+  }
+
+  void add_live(size_t type_id) {
+    add(m_live[stats_index(type_id)], 1);
+  }
+
+  void sub_live(size_t type_id) {
+    sub(m_live[stats_index(type_id)], 1);
+  }
+
+  // Releases a block allocated by this cache.
+  void release(free_block* blk) {
+    sub_live(blk->type_id);
+    recycle(blk);
+  }
+
+  // Releases a block allocated by `owner` by adding it to the current batch.
+  void release(thread_cache* owner, free_block* blk) {
+    sub_live(blk->type_id);
+    if (owner != m_pending_owner) {
+      flush();
+      m_pending_owner = owner;
+      m_pending_last = blk;
+    }
+    blk->next = m_pending_first;
+    m_pending_first = blk;
+    if (++m_pending_size == s_batch_size) {
+      flush();
+    }
+  }
+
+  // Hands the current batch back to its owner.
+  void flush() {
+    if (m_pending_first) {
+      m_pending_owner->push_remote(m_pending_first, m_pending_last);
+    }
+    m_pending_owner = nullptr;
+    m_pending_first = nullptr;
+    m_pending_last = nullptr;
+    m_pending_size = 0;
+  }
+
+  // Called from any thread to pass the list `[first, last]` to this cache.
+  void push_remote(free_block* first, free_block* last) {
+    auto top = m_remote.load();
+    do {
+      last->next = top;
+    } while (!m_remote.compare_exchange_weak(top, first));
+  }
+
+  // Moves all blocks released by other threads to the freelists.
+  void collect_remote() {
+    auto blk = m_remote.exchange(nullptr);
+    while (blk) {
+      auto next = blk->next;
+      recycle(blk);
+      blk = next;
+    }
+  }
+
+  // Returns all cached blocks to the system.
+  void clear() {
+    for (size_t i = 0; i < s_size_classes; ++i) {
+      while (m_free[i]) {
+        auto blk = m_free[i];
+        m_free[i] = blk->next;
+        ::operator delete(blk);
+      }
+      m_retained_by_class[i] = 0;
+    }
+    m_retained = 0;
+  }
+
+  size_t live_objects(size_t type_id) const {
+    return m_live[stats_index(type_id)].load(std::memory_order_relaxed);
+  }
+
+  size_t retained_bytes(size_t size_class) const {
+    return m_retained_by_class[size_class].load(std::memory_order_relaxed);
+  }
+
+ private:
+  void recycle(free_block* blk) {
+    auto bytes = block_size(blk->size_class);
+    if (m_retained + bytes > s_cache_size) {
+      ::operator delete(blk);
+      return;
+    }
+    blk->next = m_free[blk->size_class];
+    m_free[blk->size_class] = blk;
+    m_retained += bytes;
+    add(m_retained_by_class[blk->size_class], bytes);
+  }
+
+  // blocks released by other threads
+  std::atomic<free_block*> m_remote;
+  free_block* m_free[s_size_classes];
+  size_t m_retained;
+  std::atomic<size_t> m_retained_by_class[s_size_classes];
+  // may wrap around locally, since objects can die in other threads
+  std::atomic<size_t> m_live[s_max_type_ids];
+  // batch of blocks owned by another cache
+  thread_cache* m_pending_owner;
+  free_block* m_pending_first;
+  free_block* m_pending_last;
+  size_t m_pending_size;
+};
+
+// Keeps track of all caches. Caches outlive their threads, because other
+// threads may still release blocks to them, and are reused by new threads.
+class cache_registry {
+ public:
+  thread_cache* acquire() {
+    std::lock_guard<std::mutex> guard{m_mtx};
+    if (!m_unused.empty()) {
+      auto result = m_unused.back();
+      m_unused.pop_back();
+      return result;
+    }
+    auto result = new thread_cache;
+    m_all.push_back(result);
+    return result;
+  }
+
+  void release(thread_cache* ptr) {
+    std::lock_guard<std::mutex> guard{m_mtx};
+    m_unused.push_back(ptr);
+  }
+
+  template <class F>
+  void for_each(F f) {
+    std::lock_guard<std::mutex> guard{m_mtx};
+    for (auto ptr : m_all) {
+      f(*ptr);
+    }
+  }
+
+  static cache_registry& instance() {
+    // intentionally leaked, since threads may exit after static destruction
+    static auto result = new cache_registry;
+    return *result;
+  }
+
+ private:
+  std::mutex m_mtx;
+  std::vector<thread_cache*> m_all;
+  std::vector<thread_cache*> m_unused;
+};
+
+struct cache_handle {
+  thread_cache* ptr;
+
+  cache_handle() : ptr(cache_registry::instance().acquire()) {
+    // nop
+  }
+
+  ~cache_handle();
+};
+
+// remains accessible after destroying the handle of this thread
+thread_local bool s_handle_destroyed = false;
+
+cache_handle::~cache_handle() {
+  ptr->flush();
+  ptr->collect_remote();
+  ptr->clear();
+  s_handle_destroyed = true;
+  cache_registry::instance().release(ptr);
+}
+
+thread_cache* local_cache() {
+  if (s_handle_destroyed) {
+    return nullptr;
+  }
+  thread_local cache_handle handle;
+  return handle.ptr;
+}
+
+void memory_slot::request_deletion(bool) noexcept {
+  auto owner = m_owner;
+  auto size_class = m_size_class;
+  auto type_id = m_type_id;
+  this->~memory_slot();
+  auto blk = new (static_cast<void*>(this))
+             free_block{nullptr, size_class, type_id};
+  auto self = local_cache();
+  if (!owner || size_class == 0) {
+    // block was too large for the cache
+    if (self) {
+      self->sub_live(type_id);
+    }
+    ::operator delete(blk);
+  } else if (self == owner) {
+    self->release(blk);
+  } else if (self) {
+    self->release(owner, blk);
+  } else {
+    owner->push_remote(blk, blk);
+  }
+}
+
+} // namespace <anonymous>
+
+size_t memory::next_type_id() {
+  static std::atomic<size_t> s_next{1};
+  return s_next.fetch_add(1);
 }
 
-memory_cache* memory::get_cache_map_entry(const std::type_info* tinf) {
-  auto& cache = get_cache_map();
-  auto i = cache.find(tinf);
-  if (i != cache.end()) {
-    return i->second.get();
+embedded_storage memory::allocate(size_t type_id, size_t num_bytes) {
+  auto total = s_header_size + num_bytes;
+  auto size_class = (total + s_granularity - 1) / s_granularity;
+  auto owner = local_cache();
+  void* blk;
+  if (owner && size_class < s_size_classes) {
+    blk = owner->allocate(size_class, type_id);
+  } else {
+    if (owner) {
+      owner->add_live(type_id);
+    }
+    size_class = 0;
+    blk = ::operator new(total);
   }
-  return nullptr;
+  auto slot = new (blk) memory_slot(owner, static_cast<uint32_t>(size_class),
+                                    static_cast<uint32_t>(type_id));
+  return {intrusive_ptr<ref_counted>{slot, false},
+          static_cast<char*>(blk) + s_header_size};
 }
 
-void memory::add_cache_map_entry(const std::type_info* tinf,
-                                 memory_cache* instance) {
-  auto& cache = get_cache_map();
-  cache[tinf].reset(instance);
+memory_stats memory::stats(size_t type_id, size_t num_bytes) {
+  auto size_class = (s_header_size + num_bytes + s_granularity - 1)
+                    / s_granularity;
+  memory_stats result{0, 0};
+  cache_registry::instance().for_each([&](const thread_cache& x) {
+    result.live_objects += x.live_objects(type_id);
+    if (size_class < s_size_classes) {
+      result.retained_bytes += x.retained_bytes(size_class);
+    }
+  });
+  return result;
 }
 
 } // namespace detail
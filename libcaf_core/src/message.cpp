@@ -70,6 +70,10 @@ const char* message::uniform_name_at(size_t pos) const {
   return m_vals->uniform_name_at(pos);
 }
 
+uint16_t message::type_nr_at(size_t pos) const {
+  return m_vals->type_nr_at(pos);
+}
+
 bool message::equals(const message& other) const {
   CAF_ASSERT(m_vals);
   return m_vals->equals(*other.vals());
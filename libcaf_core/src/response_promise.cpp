@@ -39,4 +39,10 @@ void response_promise::deliver(message msg) const {
   to->enqueue(m_from, m_id, std::move(msg), from->host());
 }
 
+void response_promise::deliver_impl(mailbox_element_ptr what) const {
+  auto to = actor_cast<abstract_actor_ptr>(m_to);
+  auto from = actor_cast<abstract_actor_ptr>(m_from);
+  to->enqueue(std::move(what), from->host());
+}
+
 } // namespace caf
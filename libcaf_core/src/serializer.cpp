@@ -29,4 +29,8 @@ serializer::~serializer() {
   // nop
 }
 
+bool serializer::writes_raw_integers() const {
+  return false;
+}
+
 } // namespace caf
@@ -23,6 +23,7 @@
 #include "caf/exception.hpp"
 #include "caf/local_actor.hpp"
 
+#include "caf/scheduler/thread_pool.hpp"
 #include "caf/scheduler/abstract_coordinator.hpp"
 
 #include "caf/detail/logging.hpp"
@@ -42,6 +43,9 @@ std::mutex s_plugins_mtx;
 std::atomic<scheduler::abstract_coordinator*> s_scheduling_coordinator;
 std::mutex s_scheduling_coordinator_mtx;
 
+std::atomic<scheduler::thread_pool*> s_blocking_pool;
+std::mutex s_blocking_pool_mtx;
+
 std::atomic<uniform_type_info_map*> s_uniform_type_info_map;
 std::mutex s_uniform_type_info_map_mtx;
 
@@ -77,6 +81,8 @@ void singletons::stop_singletons() {
   stop(s_group_manager);
   CAF_LOGF_DEBUG("stop scheduler");
   stop(s_scheduling_coordinator);
+  CAF_LOGF_DEBUG("stop blocking pool");
+  stop(s_blocking_pool);
   CAF_LOGF_DEBUG("stop actor registry");
   stop(s_actor_registry);
   // dispose singletons, i.e., release memory
@@ -88,6 +94,8 @@ void singletons::stop_singletons() {
   dispose(s_group_manager);
   CAF_LOGF_DEBUG("dispose scheduler");
   dispose(s_scheduling_coordinator);
+  CAF_LOGF_DEBUG("dispose blocking pool");
+  dispose(s_blocking_pool);
   CAF_LOGF_DEBUG("dispose registry");
   dispose(s_actor_registry);
   // final steps
@@ -122,6 +130,10 @@ bool singletons::set_scheduling_coordinator(scheduler::abstract_coordinator*p) {
   return res == p;
 }
 
+scheduler::thread_pool* singletons::get_blocking_pool() {
+  return lazy_get(s_blocking_pool, s_blocking_pool_mtx);
+}
+
 node_id singletons::get_node_id() {
   return node_id{lazy_get(s_node_id, s_node_id_mtx)};
 }
@@ -0,0 +1,164 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/stash_index.hpp"
+
+#include "caf/system_messages.hpp"
+
+#include "caf/detail/behavior_impl.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+bool is_exit_msg(const mailbox_element& x) {
+  return x.msg.size() == 1 && x.msg.match_element<exit_msg>(0);
+}
+
+template <class Map, class Key>
+void dec(Map& xs, const Key& key) {
+  auto i = xs.find(key);
+  if (i != xs.end() && --i->second == 0) {
+    xs.erase(i);
+  }
+}
+
+} // namespace <anonymous>
+
+stash_index::scan::scan(stash_index& parent, const behavior& bhvr,
+                        message_id awaited_id, bool trap_exit)
+    : m_parent(parent),
+      m_bhvr(bhvr.as_behavior_impl()),
+      m_awaited_id(awaited_id),
+      m_trap_exit(trap_exit) {
+  // nop
+}
+
+bool stash_index::scan::needed() const {
+  auto& p = m_parent;
+  if (p.m_size == 0) {
+    return false;
+  }
+  if (same_state()) {
+    // messages enter the stash only after being skipped in the current
+    // state, i.e., the stash needs no other check until the state changes
+    return false;
+  }
+  // exit messages are handled even while awaiting a response
+  if (!m_trap_exit && p.m_exit_msgs > 0) {
+    return true;
+  }
+  if (m_awaited_id.valid()) {
+    // only the awaited response can match
+    return p.m_responses.count(m_awaited_id.integer_value()) > 0;
+  }
+  // responses that no longer have a handler are dropped when re-invoked
+  if (!p.m_responses.empty()) {
+    return true;
+  }
+  for (auto& kvp : p.m_tokens) {
+    if (may_match(kvp.first)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void stash_index::scan::completed() {
+  auto& p = m_parent;
+  p.m_checked = true;
+  p.m_checked_bhvr = m_bhvr;
+  p.m_checked_awaited_id = m_awaited_id;
+  p.m_checked_trap_exit = m_trap_exit;
+}
+
+bool stash_index::scan::accepts(const mailbox_element& x) const {
+  // exit messages are no longer ordinary messages without exit trapping,
+  // i.e., the actor handles them even while awaiting a response
+  if (!m_trap_exit && is_exit_msg(x)) {
+    return true;
+  }
+  if (m_awaited_id.valid()) {
+    return x.mid == m_awaited_id;
+  }
+  if (x.mid.is_response()) {
+    return true;
+  }
+  return may_match(x.msg.type_token());
+}
+
+bool stash_index::scan::may_match(uint32_t type_token) const {
+  return m_bhvr && m_bhvr->may_match(type_token);
+}
+
+bool stash_index::scan::same_state() const {
+  auto& p = m_parent;
+  return p.m_checked
+         && m_bhvr == p.m_checked_bhvr
+         && m_awaited_id == p.m_checked_awaited_id
+         && m_trap_exit == p.m_checked_trap_exit;
+}
+
+stash_index::stash_index()
+    : m_size(0),
+      m_exit_msgs(0),
+      m_checked_trap_exit(false),
+      m_checked(false) {
+  // nop
+}
+
+void stash_index::add(const mailbox_element& x) {
+  if (x.mid.is_response()) {
+    ++m_responses[x.mid.integer_value()];
+  } else {
+    ++m_tokens[x.msg.type_token()];
+    if (is_exit_msg(x)) {
+      ++m_exit_msgs;
+    }
+  }
+  ++m_size;
+}
+
+void stash_index::remove(const mailbox_element& x) {
+  // any change may invalidate the last check, e.g., when a handler
+  // changes the behavior while re-invoking a stashed message
+  m_checked = false;
+  if (x.mid.is_response()) {
+    dec(m_responses, x.mid.integer_value());
+  } else {
+    dec(m_tokens, x.msg.type_token());
+    if (is_exit_msg(x)) {
+      --m_exit_msgs;
+    }
+  }
+  --m_size;
+}
+
+void stash_index::clear() {
+  m_tokens.clear();
+  m_responses.clear();
+  m_size = 0;
+  m_exit_msgs = 0;
+  m_checked_bhvr.reset();
+  m_checked = false;
+}
+
+} // namespace detail
+} // namespace caf
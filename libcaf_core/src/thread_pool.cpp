@@ -0,0 +1,149 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/scheduler/thread_pool.hpp"
+
+#include <limits>
+#include <thread>
+
+#include "caf/detail/logging.hpp"
+
+namespace caf {
+namespace scheduler {
+
+struct thread_pool::state {
+  state()
+      : min_threads(0),
+        max_threads(std::numeric_limits<size_t>::max()),
+        idle_timeout(std::chrono::seconds(10)),
+        threads(0),
+        idle(0),
+        peak_threads(0),
+        saturated(0),
+        running(true) {
+    // nop
+  }
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::deque<task> tasks;
+  size_t min_threads;
+  size_t max_threads;
+  std::chrono::milliseconds idle_timeout;
+  size_t threads;
+  size_t idle;
+  size_t peak_threads;
+  size_t saturated;
+  bool running;
+};
+
+thread_pool::thread_pool() : m_state(std::make_shared<state>()) {
+  // nop
+}
+
+thread_pool::~thread_pool() {
+  stop();
+}
+
+thread_pool* thread_pool::create_singleton() {
+  return new thread_pool;
+}
+
+void thread_pool::initialize() {
+  // nop
+}
+
+void thread_pool::configure(size_t min_threads, size_t max_threads,
+                            std::chrono::milliseconds idle_timeout) {
+  std::unique_lock<std::mutex> guard{m_state->mtx};
+  m_state->max_threads = std::max<size_t>(max_threads, 1);
+  m_state->min_threads = std::min(min_threads, m_state->max_threads);
+  m_state->idle_timeout = idle_timeout;
+  // let idle threads re-evaluate their timeout
+  m_state->cv.notify_all();
+}
+
+void thread_pool::run(task f) {
+  auto& st = *m_state;
+  std::unique_lock<std::mutex> guard{st.mtx};
+  if (!st.running) {
+    guard.unlock();
+    std::thread{std::move(f)}.detach();
+    return;
+  }
+  st.tasks.push_back(std::move(f));
+  if (st.idle > st.tasks.size() - 1) {
+    st.cv.notify_one();
+    return;
+  }
+  // never queue a task, because it could occupy a thread indefinitely
+  // and all busy threads could in turn wait for this task to run
+  if (st.threads >= st.max_threads) {
+    CAF_LOG_DEBUG("all " << st.threads << " threads busy, add surplus thread");
+    ++st.saturated;
+  }
+  if (++st.threads > st.peak_threads) {
+    st.peak_threads = st.threads;
+  }
+  std::thread{work, m_state}.detach();
+}
+
+void thread_pool::stop() {
+  std::unique_lock<std::mutex> guard{m_state->mtx};
+  m_state->running = false;
+  m_state->cv.notify_all();
+}
+
+thread_pool::stats thread_pool::statistics() const {
+  std::unique_lock<std::mutex> guard{m_state->mtx};
+  auto& st = *m_state;
+  return stats{st.threads, st.idle, st.tasks.size(), st.peak_threads,
+               st.saturated};
+}
+
+void thread_pool::work(std::shared_ptr<state> ptr) {
+  auto& st = *ptr;
+  std::unique_lock<std::mutex> guard{st.mtx};
+  for (;;) {
+    if (!st.tasks.empty()) {
+      auto f = std::move(st.tasks.front());
+      st.tasks.pop_front();
+      guard.unlock();
+      f();
+      // destroy captured state before going idle
+      f = nullptr;
+      guard.lock();
+      continue;
+    }
+    if (!st.running || st.threads > st.max_threads) {
+      // surplus threads never stay in the pool
+      break;
+    }
+    ++st.idle;
+    auto status = st.cv.wait_for(guard, st.idle_timeout);
+    --st.idle;
+    if (status == std::cv_status::timeout && st.tasks.empty()
+        && st.threads > st.min_threads) {
+      break;
+    }
+  }
+  --st.threads;
+}
+
+} // namespace scheduler
+} // namespace caf
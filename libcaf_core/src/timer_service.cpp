@@ -0,0 +1,191 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/scheduler/timer_service.hpp"
+
+#include <functional>
+
+#include "caf/make_counted.hpp"
+
+#include "caf/detail/logging.hpp"
+
+namespace caf {
+namespace scheduler {
+
+timer_service::entry::entry(size_t shard_id, channel receiver,
+                            mailbox_element_ptr content)
+    : shard(shard_id),
+      to(std::move(receiver)),
+      element(std::move(content)) {
+  // nop
+}
+
+timer_service::entry::~entry() {
+  // nop
+}
+
+timer_service::shard::shard() : wakeup(0), running(false) {
+  // nop
+}
+
+timer_service::timer_service(size_t num_shards)
+    : m_epoch(clock_type::now()) {
+  if (num_shards == 0) {
+    num_shards = 1;
+  }
+  for (size_t i = 0; i < num_shards; ++i) {
+    m_shards.emplace_back(new shard);
+  }
+}
+
+timer_service::~timer_service() {
+  stop();
+}
+
+void timer_service::start() {
+  CAF_LOG_TRACE("");
+  for (auto& sh : m_shards) {
+    std::unique_lock<std::mutex> guard{sh->mtx};
+    if (sh->running) {
+      continue;
+    }
+    sh->running = true;
+    auto ptr = sh.get();
+    sh->thread = std::thread{[=] { run(*ptr); }};
+  }
+}
+
+void timer_service::stop() {
+  CAF_LOG_TRACE("");
+  for (auto& sh : m_shards) {
+    { // lifetime scope of guard
+      std::unique_lock<std::mutex> guard{sh->mtx};
+      sh->running = false;
+      sh->cv.notify_all();
+    }
+    if (sh->thread.joinable()) {
+      sh->thread.join();
+    }
+    sh->wheel.clear([](detail::timer_wheel::node* ptr) {
+      static_cast<entry*>(ptr)->deref();
+    });
+  }
+}
+
+timer_service::handle timer_service::schedule(const duration& rel_time,
+                                              actor_addr from, channel to,
+                                              message_id mid, message msg) {
+  return schedule(rel_time, std::move(to),
+                  mailbox_element::make(std::move(from), mid, std::move(msg)));
+}
+
+timer_service::handle timer_service::schedule(const duration& rel_time,
+                                              channel to,
+                                              mailbox_element_ptr what) {
+  auto hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  auto id = hash % m_shards.size();
+  auto result = make_counted<entry>(id, std::move(to), std::move(what));
+  result->deadline(deadline_tick(rel_time));
+  auto& sh = *m_shards[id];
+  std::unique_lock<std::mutex> guard{sh.mtx};
+  if (sh.wheel.empty()) {
+    // fast-forward an idle wheel to keep its levels small
+    sh.wheel.advance(current_tick(), [](detail::timer_wheel::node*) { });
+  }
+  // the wheel holds a reference until the message gets delivered or canceled
+  result->ref();
+  sh.wheel.insert(result.get());
+  if (result->deadline() < sh.wakeup) {
+    sh.cv.notify_one();
+  }
+  return result;
+}
+
+bool timer_service::cancel(const handle& hdl) {
+  if (!hdl) {
+    return false;
+  }
+  auto& sh = *m_shards[hdl->shard];
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard{sh.mtx};
+    if (!hdl->linked()) {
+      return false;
+    }
+    sh.wheel.erase(hdl.get());
+  }
+  // cannot drop the last reference, since the caller holds one
+  hdl->deref();
+  return true;
+}
+
+uint64_t timer_service::current_tick() const {
+  auto dt = clock_type::now() - m_epoch;
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<tick_duration>(dt).count());
+}
+
+uint64_t timer_service::deadline_tick(const duration& rel_time) const {
+  auto tp = clock_type::now();
+  tp += rel_time;
+  // round up to make sure timers never fire early
+  auto dt = std::chrono::duration_cast<std::chrono::nanoseconds>(tp - m_epoch);
+  auto res = std::chrono::duration_cast<std::chrono::nanoseconds>(
+               tick_duration{1});
+  return static_cast<uint64_t>((dt.count() + res.count() - 1) / res.count());
+}
+
+timer_service::clock_type::time_point
+timer_service::time_of(uint64_t tick) const {
+  return m_epoch + tick_duration{static_cast<tick_duration::rep>(tick)};
+}
+
+void timer_service::run(shard& sh) {
+  CAF_LOG_TRACE("");
+  std::vector<entry*> expired;
+  std::unique_lock<std::mutex> guard{sh.mtx};
+  while (sh.running) {
+    sh.wheel.advance(current_tick(), [&](detail::timer_wheel::node* ptr) {
+      expired.push_back(static_cast<entry*>(ptr));
+    });
+    if (!expired.empty()) {
+      // deliver without holding the lock
+      guard.unlock();
+      for (auto ptr : expired) {
+        if (ptr->to) {
+          ptr->to->enqueue(std::move(ptr->element), nullptr);
+        }
+        ptr->deref();
+      }
+      expired.clear();
+      guard.lock();
+      continue;
+    }
+    auto next = sh.wheel.next_event();
+    sh.wakeup = next;
+    if (next == detail::timer_wheel::infinite) {
+      sh.cv.wait(guard);
+    } else {
+      sh.cv.wait_until(guard, time_of(next));
+    }
+    sh.wakeup = 0;
+  }
+}
+
+} // namespace scheduler
+} // namespace caf
@@ -0,0 +1,166 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/timer_wheel.hpp"
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+// returns the number of trailing zero bits, precondition: `x != 0`
+inline size_t count_trailing_zeros(uint64_t x) {
+# if defined(CAF_GCC) || defined(CAF_CLANG)
+  return static_cast<size_t>(__builtin_ctzll(x));
+# else
+  size_t result = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    ++result;
+  }
+  return result;
+# endif
+}
+
+inline uint64_t rotate_right(uint64_t x, size_t n) {
+  return (x >> n) | (x << ((64 - n) & 63));
+}
+
+} // namespace <anonymous>
+
+timer_wheel::timer_wheel(uint64_t start_tick) : m_now(start_tick), m_size(0) {
+  m_occupied.fill(0);
+  for (auto& level : m_slots) {
+    for (auto& head : level) {
+      head.m_prev = &head;
+      head.m_next = &head;
+    }
+  }
+}
+
+void timer_wheel::insert(node* ptr) {
+  CAF_ASSERT(!ptr->linked());
+  if (ptr->m_deadline <= m_now) {
+    // the current slot has already been processed
+    ptr->m_deadline = m_now + 1;
+  }
+  ++m_size;
+  relink(ptr);
+}
+
+void timer_wheel::erase(node* ptr) {
+  CAF_ASSERT(ptr->linked());
+  unlink(ptr);
+  --m_size;
+}
+
+uint64_t timer_wheel::next_event() const {
+  auto result = infinite;
+  for (size_t level = 0; level < num_levels; ++level) {
+    auto bits = m_occupied[level];
+    if (bits == 0) {
+      continue;
+    }
+    auto shift = level * bits_per_level;
+    auto pos = (m_now >> shift) & slot_mask;
+    // distance to the next non-empty slot, the current slot comes last
+    auto dist = count_trailing_zeros(rotate_right(bits, (pos + 1) & slot_mask))
+                + 1;
+    auto tick = ((m_now >> shift) + dist) << shift;
+    if (tick < result) {
+      result = tick;
+    }
+  }
+  return result;
+}
+
+void timer_wheel::cascade() {
+  for (auto level = num_levels - 1; level > 0; --level) {
+    auto shift = level * bits_per_level;
+    if ((m_now & ((uint64_t{1} << shift) - 1)) != 0) {
+      continue;
+    }
+    auto slot = (m_now >> shift) & slot_mask;
+    auto& head = m_slots[level][slot];
+    if (head.m_next == &head) {
+      continue;
+    }
+    // detach the whole list before re-inserting, because timers
+    // parked on the top level may end up in the same slot again
+    auto first = head.m_next;
+    head.m_prev->m_next = nullptr;
+    head.m_prev = &head;
+    head.m_next = &head;
+    m_occupied[level] &= ~(uint64_t{1} << slot);
+    while (first != nullptr) {
+      auto ptr = first;
+      first = first->m_next;
+      ptr->m_level = -1;
+      relink(ptr);
+    }
+  }
+}
+
+void timer_wheel::relink(node* ptr) {
+  // precondition: ptr->m_deadline >= m_now, a deadline equal to m_now is
+  // only possible during cascade and puts the timer into the current slot
+  auto delta = ptr->m_deadline - m_now;
+  for (size_t level = 0; level < num_levels; ++level) {
+    auto shift = level * bits_per_level;
+    if (delta < (uint64_t{1} << (shift + bits_per_level))) {
+      link(ptr, level, (ptr->m_deadline >> shift) & slot_mask);
+      return;
+    }
+  }
+  // out of range: park the timer in the furthest slot of the top level
+  // and let cascade() re-insert it once the wheel gets there
+  auto level = num_levels - 1;
+  auto shift = level * bits_per_level;
+  auto parked = m_now + (uint64_t{1} << (shift + bits_per_level)) - 1;
+  link(ptr, level, (parked >> shift) & slot_mask);
+}
+
+void timer_wheel::link(node* ptr, size_t level, size_t slot) {
+  auto& head = m_slots[level][slot];
+  ptr->m_prev = head.m_prev;
+  ptr->m_next = &head;
+  head.m_prev->m_next = ptr;
+  head.m_prev = ptr;
+  ptr->m_level = static_cast<int16_t>(level);
+  ptr->m_slot = static_cast<uint16_t>(slot);
+  m_occupied[level] |= uint64_t{1} << slot;
+}
+
+void timer_wheel::unlink(node* ptr) {
+  ptr->m_prev->m_next = ptr->m_next;
+  ptr->m_next->m_prev = ptr->m_prev;
+  auto& head = m_slots[static_cast<size_t>(ptr->m_level)][ptr->m_slot];
+  if (head.m_next == &head) {
+    m_occupied[static_cast<size_t>(ptr->m_level)] &= ~(uint64_t{1}
+                                                       << ptr->m_slot);
+  }
+  ptr->m_prev = nullptr;
+  ptr->m_next = nullptr;
+  ptr->m_level = -1;
+}
+
+} // namespace detail
+} // namespace caf
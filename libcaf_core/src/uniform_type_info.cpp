@@ -101,6 +101,26 @@ std::vector<const uniform_type_info*> uniform_type_info::instances() {
   return uti_map().get_all();
 }
 
+size_t uniform_type_info::instance_size() const {
+  return 0;
+}
+
+size_t uniform_type_info::instance_alignment() const {
+  return 1;
+}
+
+void uniform_type_info::construct(void*) const {
+  throw std::logic_error("construction in place not supported");
+}
+
+void uniform_type_info::copy_construct(void*, const void*) const {
+  throw std::logic_error("construction in place not supported");
+}
+
+void uniform_type_info::destroy(void*) const {
+  throw std::logic_error("construction in place not supported");
+}
+
 const uniform_type_info* uniform_typeid_by_nr(uint16_t nr) {
   CAF_ASSERT(nr > 0 && nr < detail::type_nrs);
   return uti_map().by_type_nr(nr);
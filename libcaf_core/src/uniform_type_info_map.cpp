@@ -46,6 +46,7 @@
 #include "caf/detail/safe_equal.hpp"
 #include "caf/detail/singletons.hpp"
 #include "caf/detail/scope_guard.hpp"
+#include "caf/detail/inplace_tuple.hpp"
 #include "caf/detail/shared_spinlock.hpp"
 #include "caf/detail/uniform_type_info_map.hpp"
 #include "caf/detail/default_uniform_type_info.hpp"
@@ -102,7 +103,7 @@ inline bool operator==(const unit_t&, const unit_t&) {
 template <class T>
 inline typename std::enable_if<detail::is_primitive<T>::value>::type
 serialize_impl(const T& val, serializer* sink) {
-  sink->write_value(val);
+  sink->write(val);
 }
 
 template <class T>
@@ -416,6 +417,26 @@ class uti_impl : public uniform_type_info {
     return make_message(deref(instance));
   }
 
+  size_t instance_size() const override {
+    return sizeof(T);
+  }
+
+  size_t instance_alignment() const override {
+    return alignof(T);
+  }
+
+  void construct(void* storage) const override {
+    new (storage) T();
+  }
+
+  void copy_construct(void* storage, const void* other) const override {
+    new (storage) T(deref(other));
+  }
+
+  void destroy(void* instance) const override {
+    deref(instance).~T();
+  }
+
   static inline const T& deref(const void* ptr) {
     return *reinterpret_cast<const T*>(ptr);
   }
@@ -505,6 +526,9 @@ class default_meta_message : public uniform_type_info {
         CAF_LOG_ERROR("type name " << elements[i] << " not found");
       }
     }
+    auto first = m_elements.data();
+    m_inplace = detail::inplace_tuple::supported(first,
+                                                 first + m_elements.size());
   }
   uniform_value create(const uniform_value& other) const override {
     auto res = create_impl<message>(other);
@@ -530,6 +554,16 @@ class default_meta_message : public uniform_type_info {
     }
   }
   void deserialize(void* ptr, deserializer* source) const override {
+    if (m_inplace) {
+      // deserialize each element directly into its final position
+      auto first = m_elements.data();
+      auto tup = detail::inplace_tuple::make(first, first + m_elements.size());
+      for (size_t i = 0; i < m_elements.size(); ++i) {
+        m_elements[i]->deserialize(tup->mutable_at(i), source);
+      }
+      *cast(ptr) = message{detail::message_data::cow_ptr{std::move(tup)}};
+      return;
+    }
     message_builder mb;
     for (size_t i = 0; i < m_elements.size(); ++i) {
       mb.append(m_elements[i]->deserialize(source));
@@ -554,6 +588,7 @@ class default_meta_message : public uniform_type_info {
   }
   std::string m_name;
   std::vector<const uniform_type_info*> m_elements;
+  bool m_inplace;
 };
 
 template <class Iterator>
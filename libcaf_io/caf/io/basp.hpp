@@ -27,6 +27,8 @@
 #include "caf/binary_serializer.hpp"
 #include "caf/binary_deserializer.hpp"
 
+#include "caf/detail/type_nr.hpp"
+
 namespace caf {
 namespace io {
 namespace basp {
@@ -49,9 +51,10 @@ struct header {
 
 /**
  * The current BASP version. Different BASP versions will not
- * be able to exchange messages.
+ * be able to exchange messages. Version 3 added the operations
+ * `dispatch_compact_message` and `dispatch_multicast`.
  */
-constexpr uint64_t version = 1;
+constexpr uint64_t version = 3;
 
 /**
  * Size of a BASP header in serialized form
@@ -88,7 +91,7 @@ inline bool nonzero(T aid) {
  * dest_node      | invalid
  * source_actor   | Optional: ID of published actor
  * dest_actor     | 0
- * payload_len    | Optional: size of actor id + interface definition
+ * payload_len    | size of actor id + interface definition + type table
  * operation_data | BASP version of the server
  */
 constexpr uint32_t server_handshake = 0x00;
@@ -97,9 +100,8 @@ inline bool server_handshake_valid(const header& hdr) {
   return  valid(hdr.source_node)
        && invalid(hdr.dest_node)
        && zero(hdr.dest_actor)
-       && nonzero(hdr.operation_data)
-       && (   (nonzero(hdr.source_actor) && nonzero(hdr.payload_len))
-           || (zero(hdr.source_actor) && zero(hdr.payload_len)));
+       && nonzero(hdr.payload_len)
+       && nonzero(hdr.operation_data);
 }
 
 /**
@@ -112,7 +114,7 @@ inline bool server_handshake_valid(const header& hdr) {
  * dest_node      | ID of server
  * source_actor   | 0
  * dest_actor     | 0
- * payload_len    | 0
+ * payload_len    | size of type table
  * operation_data | 0
  */
 constexpr uint32_t client_handshake = 0x01;
@@ -123,7 +125,7 @@ inline bool client_handshake_valid(const header& hdr) {
        && hdr.source_node != hdr.dest_node
        && zero(hdr.source_actor)
        && zero(hdr.dest_actor)
-       && zero(hdr.payload_len)
+       && nonzero(hdr.payload_len)
        && zero(hdr.operation_data);
 }
 
@@ -200,6 +202,61 @@ inline bool kill_proxy_instance_valid(const header& hdr) {
        && nonzero(hdr.operation_data);
 }
 
+/**
+ * Transmits a message from source_node:source_actor to dest_node:dest_actor
+ * using the compact wire format. The payload starts with the number of
+ * elements followed by a 16-bit type ID per element, i.e., either its
+ * builtin type number or the ID the receiving node has assigned to it in
+ * its type table during the handshake. An ID of 0 is followed by the
+ * uniform name of the type. The element values follow the type IDs.
+ * Since type IDs are negotiated per connection, nodes use this operation
+ * only for messages that are not going to be forwarded.
+ *
+ * Field          | Assignment
+ * ---------------|----------------------------------------------------------
+ * source_node    | ID of sending node (invalid in case of anon_send)
+ * dest_node      | ID of receiving node
+ * source_actor   | ID of sending actor (invalid in case of anon_send)
+ * dest_actor     | ID of receiving actor, must not be invalid
+ * payload_len    | size of serialized message object, must not be 0
+ * operation_data | message ID (0 for asynchronous messages)
+ */
+constexpr uint32_t dispatch_compact_message = 0x05;
+
+/**
+ * Transmits an asynchronous message from source_node:source_actor to
+ * several actors on dest_node. The payload starts with the number of
+ * receivers followed by their actor IDs, i.e., a `uint32_t` and a list
+ * of `actor_id` values. The serialized message object follows the list.
+ * The receiving node deserializes the message only once and delivers it
+ * to each receiver locally. Nodes use this operation to fan out group
+ * messages, since a message to N receivers on the same node otherwise
+ * requires N frames with N copies of the same message.
+ *
+ * Field          | Assignment
+ * ---------------|----------------------------------------------------------
+ * source_node    | ID of sending node (invalid in case of anon_send)
+ * dest_node      | ID of receiving node
+ * source_actor   | ID of sending actor (invalid in case of anon_send)
+ * dest_actor     | 0
+ * payload_len    | size of receiver list + serialized message object
+ * operation_data | 0
+ */
+constexpr uint32_t dispatch_multicast = 0x06;
+
+inline bool dispatch_multicast_valid(const header& hdr) {
+  return  valid(hdr.dest_node)
+       && zero(hdr.dest_actor)
+       && nonzero(hdr.payload_len)
+       && zero(hdr.operation_data);
+}
+
+/**
+ * The first type ID a node assigns to announced types in its type table.
+ * All IDs below are reserved for builtin types.
+ */
+constexpr uint16_t first_announced_type_id = detail::type_nrs;
+
 /**
  * Checks whether given header is valid.
  */
@@ -212,7 +269,10 @@ inline bool valid(header& hdr) {
     case client_handshake:
       return client_handshake_valid(hdr);
     case dispatch_message:
+    case dispatch_compact_message:
       return dispatch_message_valid(hdr);
+    case dispatch_multicast:
+      return dispatch_multicast_valid(hdr);
     case announce_proxy_instance:
       return announce_proxy_instance_valid(hdr);
     case kill_proxy_instance:
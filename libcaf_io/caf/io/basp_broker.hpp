@@ -25,12 +25,15 @@
 #include <string>
 #include <future>
 #include <vector>
+#include <unordered_map>
 
 #include "caf/actor_namespace.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/binary_deserializer.hpp"
 #include "caf/forwarding_actor_proxy.hpp"
 
+#include "caf/detail/pending_table.hpp"
+
 #include "caf/io/basp.hpp"
 #include "caf/io/broker.hpp"
 
@@ -80,6 +83,12 @@ class basp_broker : public broker, public actor_namespace::backend {
   node_id dispatch(const actor_addr& from, const actor_addr& to,
                    message_id mid, const message& msg);
 
+  // dispatches an asynchronous message to several remote actors,
+  // serializing it once and sending one frame per receiving node
+  void multicast(const actor_addr& from,
+                 const std::vector<actor_addr>& receivers,
+                 const message& msg);
+
   struct client_handshake_data {
     int64_t request_id;
     actor client;
@@ -124,8 +133,29 @@ class basp_broker : public broker, public actor_namespace::backend {
     // a bug where re-using an "old" connection via
     // remote_actor() could return an expired proxy
     actor published_actor;
+    // announced types as advertised to the remote node, i.e.,
+    // `inbound_types[i]` has the type ID `first_announced_type_id + i`
+    std::vector<const uniform_type_info*> inbound_types;
+    // maps uniform names of local types to the type IDs assigned
+    // by the remote node; types with ID 0 are unknown to the remote node
+    std::unordered_map<const char*, std::pair<uint16_t,
+                                              const uniform_type_info*>>
+      outbound_types;
   };
 
+  // writes all announced types to `sink` and stores them in `ctx`
+  void write_type_table(binary_serializer& sink, connection_context& ctx);
+
+  // reads the type table of the remote node from `source`
+  void read_type_table(binary_deserializer& source, connection_context& ctx);
+
+  // serializes `msg` using type IDs negotiated with the remote node
+  void write_compact(binary_serializer& sink, connection_context& ctx,
+                     const message& msg);
+
+  // deserializes a message that has been serialized using `write_compact`
+  message read_compact(binary_deserializer& source, connection_context& ctx);
+
   void read(binary_deserializer& bs, basp::header& msg);
 
   void write(binary_serializer& bs, const basp::header& msg);
@@ -173,12 +203,9 @@ class basp_broker : public broker, public actor_namespace::backend {
 
   // node_id of the target, sender of the request, and original request ID
   using pending_request = std::tuple<node_id, actor_addr, message_id>;
-  using pending_requests = std::vector<pending_request>;
-  using pending_request_iter = pending_requests::iterator;
 
-  void fail_pending_requests(pending_request_iter first,
-                             pending_request_iter last,
-                             uint32_t reason);
+  // pending requests, keyed by the request ID without flags
+  using pending_requests = detail::pending_table<pending_request>;
 
   // fails all pending requests (total network failure or shutdown)
   void fail_pending_requests(uint32_t reason);
@@ -223,12 +250,16 @@ class basp_broker : public broker, public actor_namespace::backend {
   routing_table m_routes; // stores non-direct routes
   std::set<blacklist_entry, blacklist_less> m_blacklist; // stores invalidated
                                                          // routes
-  // a simple "bag" for our pending requests
-  std::vector<pending_request> m_pending_requests;
+  // maps incoming responses to pending requests in O(1)
+  pending_requests m_pending_requests;
 
   // needed to keep track to which node we are talking to at the moment
   connection_context* m_current_context;
 
+  // scratch buffer for the element types of the message currently being
+  // serialized or deserialized using the compact format
+  std::vector<const uniform_type_info*> m_types_buf;
+
   // cache some UTIs to make serialization a bit faster
   const uniform_type_info* m_meta_hdr;
   const uniform_type_info* m_meta_msg;
@@ -112,6 +112,13 @@ class broker : public abstract_event_based_actor<behavior, false> {
      */
     virtual void flush() = 0;
 
+    /**
+     * Releases ownership of the socket if this scribe has neither started
+     * reading nor writing, i.e., if its socket is not yet part of an event
+     * loop. Returns `invalid_native_socket` otherwise.
+     */
+    virtual network::native_socket release_socket() = 0;
+
     inline connection_handle hdl() const {
       return m_hdl;
     }
@@ -224,6 +231,18 @@ class broker : public abstract_event_based_actor<behavior, false> {
 
   void initialize() override;
 
+  /**
+   * Returns the event loop of this broker, selecting the least
+   * loaded event loop of the middleman on first call.
+   */
+  network::multiplexer& backend();
+
+  /**
+   * Runs this broker in the event loop of `ptr`.
+   * @pre `backend()` was not called previously.
+   */
+  void set_backend(network::multiplexer& ptr);
+
   template <class F, class... Ts>
   actor fork(F fun, connection_handle hdl, Ts&&... xs) {
     // provoke compile-time errors early
@@ -239,7 +258,19 @@ class broker : public abstract_event_based_actor<behavior, false> {
     auto sptr = i->second;
     CAF_ASSERT(sptr->hdl() == hdl);
     m_scribes.erase(i);
-    return spawn_functor(nullptr, [sptr](broker* forked) {
+    auto fd = sptr->release_socket();
+    if (fd != network::invalid_native_socket) {
+      // the connection is not yet bound to our event loop, which
+      // allows the forked broker to run in the least loaded one
+      return spawn_functor(nullptr, [fd](broker* forked) {
+                                      forked->add_tcp_scribe(fd);
+                                    },
+                           fun, hdl, std::forward<Ts>(xs)...);
+    }
+    // the forked broker must run in the event loop of `sptr`
+    auto mpx = &backend();
+    return spawn_functor(nullptr, [sptr, mpx](broker* forked) {
+                                    forked->set_backend(*mpx);
                                     sptr->set_broker(forked);
                                     forked->m_scribes.insert(
                                       std::make_pair(sptr->hdl(), sptr));
@@ -281,6 +312,8 @@ class broker : public abstract_event_based_actor<behavior, false> {
 
   void enqueue(mailbox_element_ptr, execution_unit*) override;
 
+  void enqueue_batch(mailbox_batch, execution_unit*) override;
+
   /**
    * Closes all connections and acceptors.
    */
@@ -347,8 +380,6 @@ class broker : public abstract_event_based_actor<behavior, false> {
     return m_mm;
   }
 
-  network::multiplexer& backend();
-
  private:
   template <class Handle, class T>
   static T& by_id(Handle hdl, std::map<Handle, intrusive_ptr<T>>& elements) {
@@ -377,6 +408,7 @@ class broker : public abstract_event_based_actor<behavior, false> {
   std::map<connection_handle, scribe_pointer> m_scribes;
 
   middleman& m_mm;
+  network::multiplexer* m_backend;
   detail::intrusive_partitioned_list<mailbox_element, detail::disposer> m_cache;
 };
 
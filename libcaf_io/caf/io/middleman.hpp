@@ -21,6 +21,7 @@
 #define CAF_IO_MIDDLEMAN_HPP
 
 #include <map>
+#include <mutex>
 #include <vector>
 #include <memory>
 #include <thread>
@@ -69,6 +70,8 @@ class middleman : public detail::abstract_singleton {
     }
     auto result = make_counted<Impl>(*this);
     CAF_ASSERT(result->unique());
+    // named brokers share the default event loop with our hooks
+    result->set_backend(backend());
     result->launch(nullptr, false, true);
     m_named_brokers.insert(std::make_pair(name, result));
     return result;
@@ -85,16 +88,50 @@ class middleman : public detail::abstract_singleton {
    */
   template <class F>
   void run_later(F fun) {
-    m_backend->post(fun);
+    backend().post(fun);
   }
 
   /**
-   * Returns the IO backend used by this middleman.
+   * Returns the default IO backend used by this middleman. Named brokers
+   * such as the BASP broker as well as hooks run in this event loop.
    */
   inline network::multiplexer& backend() {
-    return *m_backend;
+    return *m_backends.front();
   }
 
+  /**
+   * Returns the number of IO backends, i.e., event loops.
+   */
+  inline size_t num_backends() const {
+    return m_backends.size();
+  }
+
+  /**
+   * Returns the backend with the least number of brokers
+   * and adds one to its number of brokers.
+   * @note This member function is thread-safe.
+   */
+  network::multiplexer& acquire_backend();
+
+  /**
+   * Adds one to the number of brokers running in `ptr`.
+   * @note This member function is thread-safe.
+   */
+  void acquire_backend(network::multiplexer& ptr);
+
+  /**
+   * Removes one from the number of brokers running in `ptr`.
+   * @note This member function is thread-safe.
+   */
+  void release_backend(network::multiplexer& ptr);
+
+  /**
+   * Sets the number of event loops created by the middleman, whereas 0
+   * selects one event loop per four cores. Only has an effect when
+   * called before the middleman is initialized.
+   */
+  static void set_num_backends(size_t num);
+
   /**
    * Invokes the callback(s) associated with given event.
    */
@@ -134,12 +171,15 @@ class middleman : public detail::abstract_singleton {
  private:
   // guarded by singleton-getter `instance`
   middleman();
-  // networking backend
-  std::unique_ptr<network::multiplexer> m_backend;
-  // prevents backend from shutting down unless explicitly requested
-  network::multiplexer::supervisor_ptr m_backend_supervisor;
-  // runs the backend
-  std::thread m_thread;
+  // networking backends, i.e., one event loop per backend
+  std::vector<std::unique_ptr<network::multiplexer>> m_backends;
+  // prevents backends from shutting down unless explicitly requested
+  std::vector<network::multiplexer::supervisor_ptr> m_backend_supervisors;
+  // runs the backends
+  std::vector<std::thread> m_threads;
+  // number of brokers per backend, guarded by m_load_mtx
+  std::vector<size_t> m_load;
+  std::mutex m_load_mtx;
   // keeps track of "singleton-like" brokers
   std::map<atom_value, broker_ptr> m_named_brokers;
   // keeps track of anonymous brokers
@@ -22,6 +22,7 @@
 
 #include <thread>
 
+#include <atomic>
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -151,6 +152,13 @@ void nonblocking(native_socket fd, bool new_value);
  */
 std::pair<native_socket, native_socket> create_pipe();
 
+/**
+ * Creates a read and a write handle for waking up an event loop.
+ * Both handles refer to the same `eventfd` on Linux, while other
+ * platforms fall back to `create_pipe` with a nonblocking read handle.
+ */
+std::pair<native_socket, native_socket> create_wakeup_pipe();
+
 /**
  * Returns true if `fd` is configured as nodelay socket.
  * @throws network_error
@@ -183,6 +191,16 @@ bool read_some(size_t& result, native_socket fd, void* buf, size_t len);
  */
 bool write_some(size_t& result, native_socket fd, const void* buf, size_t len);
 
+/**
+ * Writes up to `len1 + len2` bytes from `buf1` followed by `buf2` to `fd`
+ * using a single gather write if supported by the platform. Returns `true`
+ * as long as `fd` is writable and `false` if the socket has been closed
+ * or an IO error occured. The number of written bytes is stored in
+ * `result` (can be 0).
+ */
+bool write_some(size_t& result, native_socket fd, const void* buf1,
+                size_t len1, const void* buf2, size_t len2);
+
 /**
  * Tries to accept a new connection from `fd`. On success,
  * the new connection is stored in `result`. Returns true
@@ -275,6 +293,16 @@ class default_socket {
     return m_parent;
   }
 
+  /**
+   * Returns the native socket and gives up ownership, i.e., the
+   * destructor of this object no longer closes the socket.
+   */
+  inline native_socket release() {
+    auto result = m_fd;
+    m_fd = invalid_native_socket;
+    return result;
+  }
+
  private:
   default_multiplexer& m_parent;
   native_socket m_fd;
@@ -398,15 +426,29 @@ class default_multiplexer : public multiplexer {
 
   void close_pipe();
 
-  void wr_dispatch_request(runnable* ptr);
+  // signals the event loop via our pipe
+  void wr_wakeup_signal();
+
+  // consumes all pending signals from our pipe
+  void rd_wakeup_signal();
 
-  runnable* rd_dispatch_request();
+  // runs all runnables that were dispatched before our pipe was signaled
+  void handle_dispatch_requests();
+
+  // marks the dispatch stack as closed, i.e., no longer accepts runnables
+  inline runnable* dispatch_stack_closed_dummy() {
+    // we are *never* going to dereference the returned pointer
+    return reinterpret_cast<runnable*>(this);
+  }
 
   native_socket m_epollfd; // unused in poll() implementation
   std::vector<multiplexer_data> m_pollset;
   std::vector<event> m_events; // always sorted by .fd
   multiplexer_poll_shadow_data m_shadow;
   std::pair<native_socket, native_socket> m_pipe;
+  // pending runnables in LIFO order; only the writer causing the
+  // transition from empty (nullptr) to non-empty signals our pipe
+  std::atomic<runnable*> m_dispatch_stack;
 };
 
 default_multiplexer& get_multiplexer_singleton();
@@ -517,7 +559,10 @@ class stream : public event_handler {
 
   /**
    * Sends the content of the write buffer, calling the `io_failure`
-   * member function of `mgr` in case of an error.
+   * member function of `mgr` in case of an error. Data is sent once the
+   * socket becomes writable, i.e., all data written to the buffer until
+   * the next iteration of the event loop is coalesced into a single write.
+   * Hence, calling this member function repeatedly is cheap.
    * @warning Must not be called outside the IO multiplexers event loop
    *          once the stream has been started.
    */
@@ -530,7 +575,8 @@ class stream : public event_handler {
       backend().add(operation::write, m_sock.fd(), this);
       m_writer = mgr;
       m_writing = true;
-      write_loop();
+      m_written = 0;
+      m_wr_buf.clear();
     }
   }
 
@@ -560,15 +606,25 @@ class stream : public event_handler {
         break;
       }
       case operation::write: {
+        // send the remainder of the current buffer along with
+        // all data that has been written to the offline buffer since
         size_t wb; // written bytes
+        auto remainder = m_wr_buf.size() - m_written;
         if (!write_some(wb, m_sock.fd(),
-                m_wr_buf.data() + m_written,
-                m_wr_buf.size() - m_written)) {
+                        m_wr_buf.data() + m_written, remainder,
+                        m_wr_offline_buf.data(), m_wr_offline_buf.size())) {
           m_writer->io_failure(operation::write);
           backend().del(operation::write, m_sock.fd(), this);
         }
         else if (wb > 0) {
-          m_written += wb;
+          if (wb >= remainder) {
+            // continue with the offline buffer
+            m_wr_buf.clear();
+            m_wr_buf.swap(m_wr_offline_buf);
+            m_written = wb - remainder;
+          } else {
+            m_written += wb;
+          }
           if (m_written >= m_wr_buf.size()) {
             // prepare next send (or stop sending)
             write_loop();
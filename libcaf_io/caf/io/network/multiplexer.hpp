@@ -118,6 +118,8 @@ class multiplexer {
    */
   struct runnable : memory_managed {
     static constexpr auto memory_cache_flag = detail::needs_embedding;
+    runnable* next; // intrusive next pointer for dispatch queues
+    runnable();
     virtual void run() = 0;
     virtual ~runnable();
   };
@@ -19,14 +19,20 @@
 
 #include "caf/io/basp_broker.hpp"
 
+#include <limits>
+#include <cstring>
+
 #include "caf/exception.hpp"
 #include "caf/make_counted.hpp"
+#include "caf/message_builder.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/binary_deserializer.hpp"
 #include "caf/forwarding_actor_proxy.hpp"
 
 #include "caf/detail/singletons.hpp"
+#include "caf/detail/inplace_tuple.hpp"
 #include "caf/detail/actor_registry.hpp"
+#include "caf/detail/uniform_type_info_map.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
 
 #include "caf/io/basp.hpp"
@@ -40,6 +46,21 @@ namespace io {
 
 using detail::singletons;
 
+namespace {
+
+// removes all requests satisfying `pred` after bouncing them
+template <class Table, class Predicate>
+void fail_pending_requests_if(Table& xs, uint32_t reason, Predicate pred) {
+  detail::sync_request_bouncer srb{reason};
+  using value_type = typename Table::value_type;
+  xs.remove_if([&](const value_type& x) { return pred(x.second); },
+               [&](const value_type& x) {
+                 srb(std::get<1>(x.second), std::get<2>(x.second));
+               });
+}
+
+} // namespace <anonymous>
+
 basp_broker::payload_writer::~payload_writer() {
   // nop
 }
@@ -163,6 +184,12 @@ behavior basp_broker::make_behavior() {
         srb(sender, mid);
       }
     },
+    on(atom("_Multicast"), arg_match) >> [=](const actor_addr& sender,
+                                             const std::vector<actor_addr>& xs,
+                                             const message& msg) {
+      CAF_LOG_TRACE("");
+      multicast(sender, xs, msg);
+    },
     on(atom("_DelProxy"), arg_match) >> [=](const node_id& nid, actor_id aid) {
       CAF_LOG_TRACE(CAF_TSARG(nid) << ", " << CAF_ARG(aid));
       erase_proxy(nid, aid);
@@ -339,17 +366,10 @@ void basp_broker::local_dispatch(const basp::header& hdr, message&& msg) {
   auto dest_addr = dest->address();
   if (mid.is_response() && !m_pending_requests.empty()) {
     // remove from pendings requests
-    auto req_id = mid.request_id();
-    auto last = m_pending_requests.end();
-    auto i = std::find(m_pending_requests.begin(), last,
-                       std::tie(hdr.source_node, dest_addr, req_id));
-    if (i != last) {
-      if (i != (last - 1)) {
-        using std::swap;
-        swap(*i, m_pending_requests.back());
-      }
-      m_pending_requests.pop_back();
-    }
+    m_pending_requests.erase_if(mid.request_id(),
+                                [&](const pending_request& req) {
+      return get<0>(req) == hdr.source_node && get<1>(req) == dest_addr;
+    });
   }
   parent().notify<hook::message_received>(hdr.source_node, src,
                                           dest_addr, mid, msg);
@@ -370,7 +390,7 @@ void basp_broker::dispatch(connection_handle hdl, uint32_t operation,
     buf.insert(buf.end(), std::begin(placeholder), std::end(placeholder));
     auto before = buf.size();
     { // lifetime scope of first serializer (write payload)
-      binary_serializer bs1{std::back_inserter(buf), &m_namespace};
+      binary_serializer bs1{&buf, &m_namespace};
       writer->write(bs1);
     }
     // write broker message to the reserved space
@@ -379,7 +399,7 @@ void basp_broker::dispatch(connection_handle hdl, uint32_t operation,
     write(bs2, {src_node,    dest_node, src_actor,   dest_actor,
                 payload_len, operation, op_data});
   } else {
-    binary_serializer bs(std::back_inserter(wr_buf(hdl)), &m_namespace);
+    binary_serializer bs{&wr_buf(hdl), &m_namespace};
     write(bs, {src_node, dest_node, src_actor, dest_actor,
                0, operation, op_data});
   }
@@ -413,23 +433,97 @@ node_id basp_broker::dispatch(const actor_addr& from, const actor_addr& to,
     auto reg = detail::singletons::get_actor_registry();
     reg->put(from.id(), actor_cast<abstract_actor_ptr>(from));
   }
-  auto writer = make_payload_writer([&](binary_serializer& sink) {
-    sink.write(msg, m_meta_msg);
-  });
-  auto route_node = dispatch(basp::dispatch_message, from.node(), from.id(),
-                             to.node(), to.id(), mid.integer_value(), &writer);
+  node_id route_node;
+  // type IDs are negotiated per connection, i.e., we can use the compact
+  // format only if the receiving node is our direct neighbor
+  auto route = get_route(to.node());
+  auto i = route.invalid() ? m_ctx.end() : m_ctx.find(route.hdl);
+  if (i != m_ctx.end() && i->second.remote_id == to.node()
+      && msg.size() <= std::numeric_limits<uint16_t>::max()) {
+    auto& ctx = i->second;
+    auto writer = make_payload_writer([&](binary_serializer& sink) {
+      write_compact(sink, ctx, msg);
+    });
+    dispatch(route.hdl, basp::dispatch_compact_message, from.node(),
+             from.id(), to.node(), to.id(), mid.integer_value(), &writer);
+    route_node = route.node;
+  } else {
+    auto writer = make_payload_writer([&](binary_serializer& sink) {
+      sink.write(msg, m_meta_msg);
+    });
+    route_node = dispatch(basp::dispatch_message, from.node(), from.id(),
+                          to.node(), to.id(), mid.integer_value(), &writer);
+  }
   if (route_node == invalid_node_id) {
     parent().notify<hook::message_sending_failed>(from, to, mid, msg);
   } else {
     if (mid.is_request()) {
       // keep track of pendings sync requests for error handling
-      m_pending_requests.emplace_back(to.node(), from, mid);
+      m_pending_requests.push_front(
+        std::make_pair(mid.request_id(), std::make_tuple(to.node(), from, mid)));
     }
     parent().notify<hook::message_sent>(from, route_node, to, mid, msg);
   }
   return route_node;
 }
 
+void basp_broker::multicast(const actor_addr& from,
+                            const std::vector<actor_addr>& receivers,
+                            const message& msg) {
+  CAF_LOG_TRACE(CAF_TSARG(from) << ", " << CAF_ARG(receivers.size())
+                << ", " << CAF_TSARG(msg));
+  if (receivers.size() == 1) {
+    // a single receiver is better off with the compact format
+    dispatch(from, receivers.front(), invalid_message_id, msg);
+    return;
+  }
+  if (from != invalid_actor_addr && from.node() == node()) {
+    // register locally running actors to be able to deserialize them later
+    auto reg = detail::singletons::get_actor_registry();
+    reg->put(from.id(), actor_cast<abstract_actor_ptr>(from));
+  }
+  std::map<node_id, std::vector<actor_addr>> by_node;
+  for (auto& receiver : receivers) {
+    if (receiver != invalid_actor_addr) {
+      by_node[receiver.node()].push_back(receiver);
+    }
+  }
+  // the regular format does not depend on the connection, i.e., we
+  // serialize the message once regardless of the number of nodes
+  buffer_type payload;
+  binary_serializer bs{&payload, &m_namespace};
+  bs.write(msg, m_meta_msg);
+  for (auto& kvp : by_node) {
+    auto& dests = kvp.second;
+    // a single receiver on a node does not need a receiver list
+    auto is_multicast = dests.size() > 1;
+    auto writer = make_payload_writer([&](binary_serializer& sink) {
+      if (is_multicast) {
+        sink.write_value(static_cast<uint32_t>(dests.size()));
+        for (auto& dest : dests) {
+          sink.write_value(dest.id());
+        }
+      }
+      sink.write_raw(payload.size(), payload.data());
+    });
+    auto route_node = dispatch(is_multicast ? basp::dispatch_multicast
+                                            : basp::dispatch_message,
+                               from.node(), from.id(), kvp.first,
+                               is_multicast ? invalid_actor_id
+                                            : dests.front().id(),
+                               0, &writer);
+    for (auto& dest : dests) {
+      if (route_node == invalid_node_id) {
+        parent().notify<hook::message_sending_failed>(from, dest,
+                                                      invalid_message_id, msg);
+      } else {
+        parent().notify<hook::message_sent>(from, route_node, dest,
+                                            invalid_message_id, msg);
+      }
+    }
+  }
+}
+
 void basp_broker::read(binary_deserializer& bd, basp::header& msg) {
   bd.read(msg.source_node, m_meta_id_type)
     .read(msg.dest_node, m_meta_id_type)
@@ -450,6 +544,113 @@ void basp_broker::write(binary_serializer& bs, const basp::header& msg) {
     .write(msg.operation_data);
 }
 
+void basp_broker::write_type_table(binary_serializer& sink,
+                                   connection_context& ctx) {
+  size_t max_types = std::numeric_limits<uint16_t>::max()
+                     - basp::first_announced_type_id + 1;
+  ctx.inbound_types.clear();
+  for (auto uti : singletons::get_uniform_type_info_map()->get_all()) {
+    // skip builtin types and message types generated on-the-fly
+    if (uti->type_nr() == 0 && strncmp(uti->name(), "@<>", 3) != 0
+        && ctx.inbound_types.size() < max_types) {
+      ctx.inbound_types.push_back(uti);
+    }
+  }
+  sink.write(static_cast<uint32_t>(ctx.inbound_types.size()));
+  for (auto uti : ctx.inbound_types) {
+    sink.write(string{uti->name()});
+  }
+}
+
+void basp_broker::read_type_table(binary_deserializer& source,
+                                  connection_context& ctx) {
+  auto uti_map = singletons::get_uniform_type_info_map();
+  ctx.outbound_types.clear();
+  auto num_types = source.read<uint32_t>();
+  for (uint32_t i = 0; i < num_types; ++i) {
+    auto tname = source.read<string>();
+    auto uti = uti_map->by_uniform_name(tname);
+    if (uti) {
+      auto id = static_cast<uint16_t>(basp::first_announced_type_id + i);
+      ctx.outbound_types.emplace(uti->name(), std::make_pair(id, uti));
+    }
+  }
+}
+
+void basp_broker::write_compact(binary_serializer& sink,
+                                connection_context& ctx, const message& msg) {
+  auto uti_map = singletons::get_uniform_type_info_map();
+  // write all type IDs first to allow the receiver to
+  // allocate the message before deserializing its elements
+  m_types_buf.clear();
+  sink.write(static_cast<uint16_t>(msg.size()));
+  for (size_t i = 0; i < msg.size(); ++i) {
+    auto nr = msg.type_nr_at(i);
+    if (nr != 0) {
+      sink.write(nr);
+      m_types_buf.push_back(uti_map->by_type_nr(nr));
+      continue;
+    }
+    auto tname = msg.uniform_name_at(i);
+    auto j = ctx.outbound_types.find(tname);
+    if (j == ctx.outbound_types.end()) {
+      // type is unknown to the remote node, e.g., because it has been
+      // announced after the handshake; remember to send its name instead
+      auto uti = uniform_type_info::from(tname);
+      j = ctx.outbound_types.emplace(tname, std::make_pair(uint16_t{0},
+                                                           uti)).first;
+    }
+    auto& entry = j->second;
+    sink.write(entry.first);
+    if (entry.first == 0) {
+      sink.write(string{tname});
+    }
+    m_types_buf.push_back(entry.second);
+  }
+  for (size_t i = 0; i < msg.size(); ++i) {
+    m_types_buf[i]->serialize(msg.at(i), &sink);
+  }
+}
+
+message basp_broker::read_compact(binary_deserializer& source,
+                                  connection_context& ctx) {
+  auto uti_map = singletons::get_uniform_type_info_map();
+  auto num_elements = source.read<uint16_t>();
+  m_types_buf.clear();
+  for (uint16_t i = 0; i < num_elements; ++i) {
+    auto id = source.read<uint16_t>();
+    const uniform_type_info* uti;
+    if (id == 0) {
+      uti = uti_map->by_uniform_name(source.read<string>());
+    } else if (id < basp::first_announced_type_id) {
+      uti = uti_map->by_type_nr(id);
+    } else {
+      size_t pos = id - basp::first_announced_type_id;
+      uti = pos < ctx.inbound_types.size() ? ctx.inbound_types[pos] : nullptr;
+    }
+    if (!uti) {
+      std::string err = "received unknown type ID ";
+      err += std::to_string(id);
+      throw std::runtime_error(err);
+    }
+    m_types_buf.push_back(uti);
+  }
+  auto first = m_types_buf.data();
+  auto last = first + m_types_buf.size();
+  if (detail::inplace_tuple::supported(first, last)) {
+    auto tup = detail::inplace_tuple::make(first, last);
+    for (size_t i = 0; i < m_types_buf.size(); ++i) {
+      m_types_buf[i]->deserialize(tup->mutable_at(i), &source);
+    }
+    return message{detail::message_data::cow_ptr{std::move(tup)}};
+  }
+  message_builder mb;
+  for (auto uti : m_types_buf) {
+    mb.append(uti->deserialize(&source));
+  }
+  return mb.to_message();
+}
+
 basp_broker::connection_state
 basp_broker::handle_basp_header(connection_context& ctx,
                                 const buffer_type* payload) {
@@ -484,7 +685,7 @@ basp_broker::handle_basp_header(connection_context& ctx,
     CAF_LOG_DEBUG("received message that is not addressed to us -> "
                   << "forward via " << to_string(route.node));
     auto& buf = wr_buf(route.hdl);
-    binary_serializer bs{std::back_inserter(buf), &m_namespace};
+    binary_serializer bs{&buf, &m_namespace};
     write(bs, hdr);
     if (payload) {
       buf.insert(buf.end(), payload->begin(), payload->end());
@@ -507,6 +708,35 @@ basp_broker::handle_basp_header(connection_context& ctx,
       local_dispatch(ctx.hdr, std::move(content));
       break;
     }
+    case basp::dispatch_multicast: {
+      CAF_ASSERT(payload != nullptr);
+      binary_deserializer bd{payload->data(), payload->size(), &m_namespace};
+      uint32_t num_receivers;
+      bd.read(num_receivers);
+      if (num_receivers > payload->size() / sizeof(actor_id)) {
+        CAF_LOG_INFO("received multicast with invalid receiver list");
+        return close_connection;
+      }
+      std::vector<actor_id> receivers(num_receivers);
+      for (auto& receiver : receivers) {
+        bd.read(receiver);
+      }
+      message content;
+      bd.read(content, m_meta_msg);
+      // all receivers share the deserialized message
+      auto hdr_copy = ctx.hdr;
+      for (auto receiver : receivers) {
+        hdr_copy.dest_actor = receiver;
+        local_dispatch(hdr_copy, message{content});
+      }
+      break;
+    }
+    case basp::dispatch_compact_message: {
+      CAF_ASSERT(payload != nullptr);
+      binary_deserializer bd{payload->data(), payload->size(), &m_namespace};
+      local_dispatch(ctx.hdr, read_compact(bd, ctx));
+      break;
+    }
     case basp::announce_proxy_instance: {
       CAF_ASSERT(payload == nullptr);
       // source node has created a proxy for one of our actors
@@ -540,11 +770,13 @@ basp_broker::handle_basp_header(connection_context& ctx,
       break;
     }
     case basp::client_handshake: {
-      CAF_ASSERT(payload == nullptr);
+      CAF_ASSERT(payload != nullptr);
       if (ctx.remote_id != invalid_node_id) {
         CAF_LOG_INFO("received unexpected client handshake");
         return close_connection;
       }
+      binary_deserializer bd{payload->data(), payload->size(), &m_namespace};
+      read_type_table(bd, ctx);
       ctx.remote_id = hdr.source_node;
       if (node() == ctx.remote_id) {
         CAF_LOG_INFO("incoming connection from self");
@@ -576,6 +808,7 @@ basp_broker::handle_basp_header(connection_context& ctx,
         auto str = bd.read<string>();
         remote_ifs.insert(std::move(str));
       }
+      read_type_table(bd, ctx);
       auto& ifs = ctx.handshake_data->expected_ifs;
       auto hsclient = ctx.handshake_data->client;
       auto hsid = ctx.handshake_data->request_id;
@@ -640,8 +873,11 @@ basp_broker::handle_basp_header(connection_context& ctx,
         return close_connection;
       }
       // finalize handshake
+      auto writer = make_payload_writer([&](binary_serializer& sink) {
+        write_type_table(sink, ctx);
+      });
       dispatch(ctx.hdl, basp::client_handshake,
-               node(), invalid_actor_id, nid, invalid_actor_id);
+               node(), invalid_actor_id, nid, invalid_actor_id, 0, &writer);
       // prepare to receive messages
       auto proxy = m_namespace.get_or_put(nid, remote_aid);
       ctx.published_actor = proxy;
@@ -775,21 +1011,18 @@ void basp_broker::init_handshake_as_server(connection_context& ctx,
                                            actor_addr addr) {
   CAF_LOG_TRACE(CAF_ARG(this));
   CAF_ASSERT(node() != invalid_node_id);
-  if (addr != invalid_actor_addr) {
-    auto writer = make_payload_writer([&](binary_serializer& sink) {
-      sink << addr.id();
-      auto sigs = addr.message_types();
-      sink << static_cast<uint32_t>(sigs.size());
-      for (auto& sig : sigs) {
-        sink << sig;
-      }
-    });
-    dispatch(ctx.hdl, basp::server_handshake, node(), addr.id(),
-             invalid_node_id, invalid_actor_id, basp::version, &writer);
-  } else {
-    dispatch(ctx.hdl, basp::server_handshake, node(), invalid_actor_id,
-             invalid_node_id, invalid_actor_id, basp::version);
-  }
+  auto writer = make_payload_writer([&](binary_serializer& sink) {
+    // writes an ID of 0 and an empty interface for invalid addresses
+    sink << addr.id();
+    auto sigs = addr.message_types();
+    sink << static_cast<uint32_t>(sigs.size());
+    for (auto& sig : sigs) {
+      sink << sig;
+    }
+    write_type_table(sink, ctx);
+  });
+  dispatch(ctx.hdl, basp::server_handshake, node(), addr.id(),
+           invalid_node_id, invalid_actor_id, basp::version, &writer);
   // prepare for receiving client handshake
   ctx.state = await_client_handshake;
   configure_read(ctx.hdl, receive_policy::exactly(basp::header_size));
@@ -862,35 +1095,18 @@ bool basp_broker::remove_published_actor(const abstract_actor_ptr& whom,
   return true;
 }
 
-void basp_broker::fail_pending_requests(pending_request_iter first,
-                                        pending_request_iter last,
-                                        uint32_t reason) {
-  CAF_LOG_TRACE(std::distance(first, last) << " elements, " << CAF_ARG(reason));
-  if (first == last) {
-    return;
-  }
-  detail::sync_request_bouncer srb{reason};
-  auto bounce = [&](const pending_request& req) {
-    srb(get<1>(req), get<2>(req));
-  };
-  std::for_each(first, last, bounce);
-  m_pending_requests.erase(first, last);
-}
-
 void basp_broker::fail_pending_requests(uint32_t reason) {
   CAF_LOG_TRACE(CAF_ARG(reason));
-  fail_pending_requests(m_pending_requests.begin(), m_pending_requests.end(),
-                        reason);
+  fail_pending_requests_if(m_pending_requests, reason,
+                           [](const pending_request&) { return true; });
 }
 
 void basp_broker::fail_pending_requests(const node_id& addr, uint32_t reason) {
   CAF_LOG_TRACE(CAF_TSARG(addr) << ", " << CAF_ARG(reason));
-  auto f = [&](const pending_request& req) {
-    return get<0>(req) == addr;
-  };
-  auto last = m_pending_requests.end();
-  fail_pending_requests(std::remove_if(m_pending_requests.begin(), last, f),
-                        last, reason);
+  fail_pending_requests_if(m_pending_requests, reason,
+                           [&](const pending_request& req) {
+                             return get<0>(req) == addr;
+                           });
 }
 
 } // namespace io
@@ -189,6 +189,7 @@ void broker::invoke_message(mailbox_element_ptr& ptr) {
       case im_skipped: {
         CAF_LOG_DEBUG("handle_message returned hm_skip_msg or hm_cache_msg");
         if (ptr) {
+          m_stash.add(*ptr);
           m_cache.push_second_back(ptr.release());
         }
         break;
@@ -229,14 +230,26 @@ void broker::invoke_message(const actor_addr& v0, message_id v1, message& v2) {
 
 bool broker::invoke_message_from_cache() {
   CAF_LOG_TRACE("");
+  if (m_stash.size() == 0) {
+    return false;
+  }
   auto& bhvr = this->awaits_response()
                ? this->awaited_response_handler()
                : this->bhvr_stack().back();
   auto bid = this->awaited_response_id();
+  detail::stash_index::scan filter{m_stash, bhvr, bid, trap_exit()};
+  if (!filter.needed()) {
+    return false;
+  }
   auto i = m_cache.second_begin();
   auto e = m_cache.second_end();
-  CAF_LOG_DEBUG(std::distance(i, e) << " elements in cache");
-  return m_cache.invoke(static_cast<local_actor*>(this), i, e, bhvr, bid);
+  CAF_LOG_DEBUG(m_stash.size() << " elements in cache");
+  if (m_cache.invoke(static_cast<local_actor*>(this), i, e, bhvr, bid,
+                     filter)) {
+    return true;
+  }
+  filter.completed();
+  return false;
 }
 
 void broker::write(connection_handle hdl, size_t bs, const void* buf) {
@@ -247,7 +260,7 @@ void broker::write(connection_handle hdl, size_t bs, const void* buf) {
 }
 
 void broker::enqueue(mailbox_element_ptr ptr, execution_unit*) {
-  parent().backend().post(continuation{this, std::move(ptr)});
+  backend().post(continuation{this, std::move(ptr)});
 }
 
 void broker::enqueue(const actor_addr& sender, message_id mid, message msg,
@@ -255,11 +268,16 @@ void broker::enqueue(const actor_addr& sender, message_id mid, message msg,
   enqueue(mailbox_element::make(sender, mid, std::move(msg)), eu);
 }
 
-broker::broker() : m_mm(*middleman::instance()) {
+void broker::enqueue_batch(mailbox_batch batch, execution_unit* eu) {
+  // brokers receive all messages via the multiplexer
+  abstract_channel::enqueue_batch(std::move(batch), eu);
+}
+
+broker::broker() : m_mm(*middleman::instance()), m_backend(nullptr) {
   // nop
 }
 
-broker::broker(middleman& ptr) : m_mm(ptr) {
+broker::broker(middleman& ptr) : m_mm(ptr), m_backend(nullptr) {
   // nop
 }
 
@@ -272,6 +290,9 @@ void broker::cleanup(uint32_t reason) {
   CAF_ASSERT(m_scribes.empty());
   CAF_ASSERT(current_mailbox_element() == nullptr);
   m_cache.clear();
+  if (m_backend) {
+    m_mm.release_backend(*m_backend);
+  }
   super::cleanup(reason);
   deref(); // release implicit reference count from middleman
 }
@@ -375,7 +396,18 @@ behavior broker::functor_based::make_behavior() {
 }
 
 network::multiplexer& broker::backend() {
-  return m_mm.backend();
+  if (!m_backend) {
+    // no need to synchronize, since this member function is called
+    // at the latest in launch() before any other thread knows us
+    m_backend = &m_mm.acquire_backend();
+  }
+  return *m_backend;
+}
+
+void broker::set_backend(network::multiplexer& ptr) {
+  CAF_ASSERT(m_backend == nullptr);
+  m_mm.acquire_backend(ptr);
+  m_backend = &ptr;
 }
 
 connection_handle broker::add_tcp_scribe(const std::string& hst, uint16_t prt) {
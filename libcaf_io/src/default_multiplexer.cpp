@@ -39,6 +39,7 @@
 # include <errno.h>
 # include <netdb.h>
 # include <fcntl.h>
+# include <sys/uio.h>
 # include <sys/types.h>
 # include <arpa/inet.h>
 # include <sys/socket.h>
@@ -46,6 +47,10 @@
 # include <netinet/tcp.h>
 #endif
 
+#ifdef CAF_LINUX
+# include <sys/eventfd.h>
+#endif
+
 using std::string;
 
 namespace {
@@ -246,6 +251,18 @@ namespace network {
 
 #endif
 
+std::pair<native_socket, native_socket> create_wakeup_pipe() {
+# ifdef CAF_LINUX
+    auto fd = ccall(cc_not_minus1, "cannot create eventfd",
+                    eventfd, 0, EFD_CLOEXEC | EFD_NONBLOCK);
+    return {fd, fd};
+# else
+    auto result = create_pipe();
+    nonblocking(result.first, true);
+    return result;
+# endif
+}
+
 /******************************************************************************
  *                             epoll() xs. poll()                             *
  ******************************************************************************/
@@ -257,7 +274,8 @@ namespace network {
 
   default_multiplexer::default_multiplexer()
       : m_epollfd(invalid_native_socket),
-        m_shadow(1) {
+        m_shadow(1),
+        m_dispatch_stack(nullptr) {
     init();
     m_epollfd = epoll_create1(EPOLL_CLOEXEC);
     if (m_epollfd == -1) {
@@ -266,7 +284,7 @@ namespace network {
     }
     // handle at most 64 events at a time
     m_pollset.resize(64);
-    m_pipe = create_pipe();
+    m_pipe = create_wakeup_pipe();
     epoll_event ee;
     ee.events = input_mask;
     ee.data.ptr = nullptr;
@@ -388,10 +406,12 @@ namespace network {
   // are sorted by the file descriptor. This allows us to quickly,
   // i.e., O(1), access the actual object when handling socket events.
 
-  default_multiplexer::default_multiplexer() : m_epollfd(-1) {
+  default_multiplexer::default_multiplexer()
+      : m_epollfd(-1),
+        m_dispatch_stack(nullptr) {
     init();
     // initial setup
-    m_pipe = create_pipe();
+    m_pipe = create_wakeup_pipe();
     pollfd pipefd;
     pipefd.fd = m_pipe.first;
     pipefd.events = input_mask;
@@ -581,38 +601,62 @@ void default_multiplexer::del(operation op, native_socket fd,
   new_event(del_flag, op, fd, ptr);
 }
 
-void default_multiplexer::wr_dispatch_request(runnable* ptr) {
-  intptr_t ptrval = reinterpret_cast<intptr_t>(ptr);
+void default_multiplexer::wr_wakeup_signal() {
   // on windows, we actually have sockets, otherwise we have file handles
 # ifdef CAF_WINDOWS
-    auto res = ::send(m_pipe.second, reinterpret_cast<socket_send_ptr>(&ptrval),
-                      sizeof(ptrval), no_sigpipe_flag);
+    char token = 0;
+    auto res = ::send(m_pipe.second, &token, sizeof(token), no_sigpipe_flag);
+# elif defined(CAF_LINUX)
+    uint64_t token = 1; // eventfd requires 8 byte writes
+    auto res = ::write(m_pipe.second, &token, sizeof(token));
 # else
-    auto res = ::write(m_pipe.second, &ptrval, sizeof(ptrval));
+    char token = 0;
+    auto res = ::write(m_pipe.second, &token, sizeof(token));
 # endif
   if (res <= 0) {
-    // pipe closed, discard runnable
-    ptr->request_deletion(false);
-  } else if (static_cast<size_t>(res) < sizeof(ptrval)) {
-    // must not happen: wrote invalid pointer to pipe
-    std::cerr << "[CAF] Fatal error: wrote invalid data to pipe" << std::endl;
-    abort();
+    // pipe closed, runnables remain in the queue until we shut down
+    CAF_LOG_DEBUG("unable to signal event loop: "
+                  << last_socket_error_as_string());
   }
 }
 
-default_multiplexer::runnable* default_multiplexer::rd_dispatch_request() {
-  intptr_t ptrval;
+void default_multiplexer::rd_wakeup_signal() {
   // on windows, we actually have sockets, otherwise we have file handles
 # ifdef CAF_WINDOWS
-    auto res = recv(m_pipe.first, reinterpret_cast<socket_recv_ptr>(&ptrval),
-                    sizeof(ptrval), 0);
+    char buf[64];
+    while (recv(m_pipe.first, buf, sizeof(buf), 0) > 0) {
+      // nop
+    }
+# elif defined(CAF_LINUX)
+    uint64_t counter;
+    // reading from an eventfd resets its counter
+    static_cast<void>(read(m_pipe.first, &counter, sizeof(counter)));
 # else
-    auto res = read(m_pipe.first, &ptrval, sizeof(ptrval));
+    char buf[64];
+    while (read(m_pipe.first, buf, sizeof(buf)) > 0) {
+      // nop
+    }
 # endif
-  if (res != sizeof(ptrval)) {
-    return nullptr;
+}
+
+void default_multiplexer::handle_dispatch_requests() {
+  // take all pending runnables at once; any runnable dispatched from now
+  // on finds an empty stack and thus signals our pipe again
+  auto e = m_dispatch_stack.exchange(nullptr);
+  CAF_ASSERT(e != dispatch_stack_closed_dummy());
+  // restore FIFO order
+  runnable* head = nullptr;
+  while (e) {
+    auto next = e->next;
+    e->next = head;
+    head = e;
+    e = next;
+  }
+  while (head) {
+    runnable_ptr ptr{head};
+    head = head->next;
+    ptr->run();
   }
-  return reinterpret_cast<runnable*>(ptrval);;
 }
 
 default_multiplexer& get_multiplexer_singleton() {
@@ -664,9 +708,8 @@ void default_multiplexer::handle_socket_event(native_socket fd, int mask,
     } else {
       CAF_ASSERT(fd == m_pipe.first);
       CAF_LOG_DEBUG("read message from pipe");
-      auto cb = rd_dispatch_request();
-      cb->run();
-      cb->request_deletion(false);
+      rd_wakeup_signal();
+      handle_dispatch_requests();
     }
   }
   if (mask & output_mask) {
@@ -707,23 +750,40 @@ default_multiplexer::~default_multiplexer() {
   if (m_epollfd != invalid_native_socket) {
     closesocket(m_epollfd);
   }
-  // close write handle first
+  // discard all remaining runnables
+  auto e = m_dispatch_stack.exchange(dispatch_stack_closed_dummy());
+  while (e) {
+    auto next = e->next;
+    e->request_deletion(false);
+    e = next;
+  }
   closesocket(m_pipe.second);
-  // flush pipe before closing it
-  nonblocking(m_pipe.first, true);
-  auto ptr = rd_dispatch_request();
-  while (ptr) {
-    ptr->request_deletion(false);
-    ptr = rd_dispatch_request();
+  if (m_pipe.first != m_pipe.second) {
+    closesocket(m_pipe.first);
   }
-  closesocket(m_pipe.first);
 # ifdef CAF_WINDOWS
     WSACleanup();
 # endif
 }
 
 void default_multiplexer::dispatch_runnable(runnable_ptr ptr) {
-  wr_dispatch_request(ptr.release());
+  auto new_top = ptr.release();
+  auto e = m_dispatch_stack.load();
+  for (;;) {
+    if (e == dispatch_stack_closed_dummy()) {
+      // multiplexer is shutting down, discard runnable
+      new_top->request_deletion(false);
+      return;
+    }
+    new_top->next = e;
+    if (m_dispatch_stack.compare_exchange_weak(e, new_top)) {
+      break;
+    }
+    // continue with new value of e
+  }
+  if (e == nullptr) {
+    wr_wakeup_signal();
+  }
 }
 
 connection_handle default_multiplexer::add_tcp_scribe(broker* self,
@@ -731,10 +791,11 @@ connection_handle default_multiplexer::add_tcp_scribe(broker* self,
   CAF_LOG_TRACE("");
   class impl : public broker::scribe {
    public:
-    impl(broker* ptr, default_socket&& s)
+    impl(default_multiplexer& mx, broker* ptr, default_socket&& s)
         : scribe(ptr, network::conn_hdl_from_socket(s)),
           m_launched(false),
-          m_stream(s.backend()) {
+          m_flushed(false),
+          m_stream(mx) {
       m_stream.init(std::move(s));
     }
     void configure_read(receive_policy::config config) override {
@@ -755,8 +816,18 @@ connection_handle default_multiplexer::add_tcp_scribe(broker* self,
     }
     void flush() override {
       CAF_LOG_TRACE("");
+      if (!m_stream.wr_buf().empty()) {
+        m_flushed = true;
+      }
       m_stream.flush(this);
     }
+    native_socket release_socket() override {
+      CAF_LOG_TRACE("");
+      if (m_launched || m_flushed) {
+        return invalid_native_socket;
+      }
+      return m_stream.socket_handle().release();
+    }
     void launch() {
       CAF_LOG_TRACE("");
       CAF_ASSERT(!m_launched);
@@ -765,9 +836,11 @@ connection_handle default_multiplexer::add_tcp_scribe(broker* self,
     }
    private:
     bool m_launched;
+    bool m_flushed;
     stream<default_socket> m_stream;
   };
-  broker::scribe_pointer ptr = make_counted<impl>(self, std::move(sock));
+  broker::scribe_pointer ptr = make_counted<impl>(*this, self,
+                                                 std::move(sock));
   self->add_scribe(ptr);
   return ptr->hdl();
 }
@@ -779,9 +852,9 @@ default_multiplexer::add_tcp_doorman(broker* self,
   CAF_ASSERT(sock.fd() != network::invalid_native_socket);
   class impl : public broker::doorman {
    public:
-    impl(broker* ptr, default_socket_acceptor&& s)
+    impl(default_multiplexer& mx, broker* ptr, default_socket_acceptor&& s)
         : doorman(ptr, network::accept_hdl_from_socket(s)),
-          m_acceptor(s.backend()) {
+          m_acceptor(mx) {
       m_acceptor.init(std::move(s));
     }
     void new_connection() override {
@@ -804,7 +877,8 @@ default_multiplexer::add_tcp_doorman(broker* self,
    private:
     network::acceptor<default_socket_acceptor> m_acceptor;
   };
-  broker::doorman_pointer ptr = make_counted<impl>(self, std::move(sock));
+  broker::doorman_pointer ptr = make_counted<impl>(*this, self,
+                                                 std::move(sock));
   self->add_doorman(ptr);
   return ptr->hdl();
 }
@@ -909,6 +983,36 @@ bool write_some(size_t& result, native_socket fd, const void* buf, size_t len) {
   return true;
 }
 
+bool write_some(size_t& result, native_socket fd, const void* buf1,
+                size_t len1, const void* buf2, size_t len2) {
+  CAF_LOGF_TRACE(CAF_ARG(fd) << ", " << CAF_ARG(len1) << ", " << CAF_ARG(len2));
+  if (len1 == 0 || len2 == 0) {
+    return len1 == 0 ? write_some(result, fd, buf2, len2)
+                     : write_some(result, fd, buf1, len1);
+  }
+# ifdef CAF_WINDOWS
+    // no gather write available, send first buffer only
+    return write_some(result, fd, buf1, len1);
+# else
+    iovec iov[2];
+    iov[0].iov_base = const_cast<void*>(buf1);
+    iov[0].iov_len = len1;
+    iov[1].iov_base = const_cast<void*>(buf2);
+    iov[1].iov_len = len2;
+    msghdr msg;
+    memset(&msg, 0, sizeof(msghdr));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+    auto sres = ::sendmsg(fd, &msg, no_sigpipe_flag);
+    CAF_LOGF_DEBUG("tried to write " << (len1 + len2) << " bytes to socket "
+                   << fd << ", sendmsg returned " << sres);
+    if (is_error(sres, true))
+      return false;
+    result = (sres > 0) ? static_cast<size_t>(sres) : 0;
+    return true;
+# endif
+}
+
 bool try_accept(native_socket& result, native_socket fd) {
   CAF_LOGF_TRACE(CAF_ARG(fd));
   sockaddr addr;
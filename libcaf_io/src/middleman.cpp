@@ -18,10 +18,12 @@
  ******************************************************************************/
 
 #include <tuple>
+#include <atomic>
 #include <cerrno>
 #include <memory>
 #include <cstring>
 #include <sstream>
+#include <algorithm>
 #include <stdexcept>
 
 #include "caf/on.hpp"
@@ -58,6 +60,9 @@ namespace io {
 
 namespace {
 
+// configured via middleman::set_num_backends, 0 means "auto"
+std::atomic<size_t> s_num_backends{0};
+
 template <class Subtype>
 inline void serialize_impl(const handle<Subtype>& hdl, serializer* sink) {
   sink->write_value(hdl.id());
@@ -342,13 +347,21 @@ void middleman::add_broker(broker_ptr bptr) {
 
 void middleman::initialize() {
   CAF_LOG_TRACE("");
-  m_backend = network::multiplexer::make();
-  m_backend_supervisor = m_backend->make_supervisor();
-  m_thread = std::thread([this] {
-    CAF_LOG_TRACE("");
-    m_backend->run();
-  });
-  m_backend->thread_id(m_thread.get_id());
+  auto num = s_num_backends.load();
+  if (num == 0) {
+    num = std::max<size_t>(1, std::thread::hardware_concurrency() / 4);
+  }
+  m_load.resize(num, 0);
+  for (size_t i = 0; i < num; ++i) {
+    m_backends.push_back(network::multiplexer::make());
+    auto mpx = m_backends.back().get();
+    m_backend_supervisors.push_back(mpx->make_supervisor());
+    m_threads.emplace_back([this, mpx] {
+      CAF_LOG_TRACE("");
+      mpx->run();
+    });
+    mpx->thread_id(m_threads.back().get_id());
+  }
   // announce io-related types
   do_announce<new_data_msg>("caf::io::new_data_msg");
   do_announce<new_connection_msg>("caf::io::new_connection_msg");
@@ -366,7 +379,7 @@ void middleman::initialize() {
 
 void middleman::stop() {
   CAF_LOG_TRACE("");
-  m_backend->dispatch([=] {
+  backend().dispatch([=] {
     CAF_LOG_TRACE("");
     // m_managers will be modified while we are stopping each manager,
     // because each manager will call remove(...)
@@ -376,8 +389,10 @@ void middleman::stop() {
       }
     }
   });
-  m_backend_supervisor.reset();
-  m_thread.join();
+  m_backend_supervisors.clear();
+  for (auto& t : m_threads) {
+    t.join();
+  }
   m_named_brokers.clear();
   scoped_actor self(true);
   self->monitor(m_manager);
@@ -397,6 +412,38 @@ middleman::middleman() {
   // nop
 }
 
+network::multiplexer& middleman::acquire_backend() {
+  std::lock_guard<std::mutex> guard{m_load_mtx};
+  auto i = std::min_element(m_load.begin(), m_load.end());
+  ++*i;
+  return *m_backends[static_cast<size_t>(std::distance(m_load.begin(), i))];
+}
+
+void middleman::acquire_backend(network::multiplexer& ptr) {
+  std::lock_guard<std::mutex> guard{m_load_mtx};
+  for (size_t i = 0; i < m_backends.size(); ++i) {
+    if (m_backends[i].get() == &ptr) {
+      ++m_load[i];
+      return;
+    }
+  }
+}
+
+void middleman::release_backend(network::multiplexer& ptr) {
+  std::lock_guard<std::mutex> guard{m_load_mtx};
+  for (size_t i = 0; i < m_backends.size(); ++i) {
+    if (m_backends[i].get() == &ptr) {
+      CAF_ASSERT(m_load[i] > 0);
+      --m_load[i];
+      return;
+    }
+  }
+}
+
+void middleman::set_num_backends(size_t num) {
+  s_num_backends = num;
+}
+
 middleman::~middleman() {
   // nop
 }
@@ -52,6 +52,10 @@ multiplexer::supervisor::~supervisor() {
   // nop
 }
 
+multiplexer::runnable::runnable() : next(nullptr) {
+  // nop
+}
+
 multiplexer::runnable::~runnable() {
   // nop
 }
@@ -0,0 +1,164 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/detail/singletons.hpp"
+#include "caf/detail/actor_registry.hpp"
+
+using namespace caf;
+
+using detail::singletons;
+
+namespace {
+
+constexpr size_t num_actors = 1000;
+
+behavior dummy() {
+  return {
+    others >> [] {
+      // nop
+    }
+  };
+}
+
+std::atomic<size_t> s_destroyed{0};
+
+class counted : public event_based_actor {
+ public:
+  ~counted() {
+    ++s_destroyed;
+  }
+
+  behavior make_behavior() override {
+    return dummy();
+  }
+};
+
+void test_put_and_erase() {
+  CAF_PRINT("test_put_and_erase");
+  auto reg = singletons::get_actor_registry();
+  auto before = reg->size();
+  std::vector<actor> actors;
+  for (size_t i = 0; i < num_actors; ++i) {
+    auto a = spawn(dummy);
+    reg->put(a->id(), actor_cast<abstract_actor_ptr>(a));
+    // adding an actor twice has no effect
+    reg->put(a->id(), actor_cast<abstract_actor_ptr>(a));
+    actors.push_back(a);
+  }
+  CAF_CHECK_EQUAL(reg->size(), before + num_actors);
+  for (auto& a : actors) {
+    CAF_CHECK(reg->get(a->id()) == actor_cast<abstract_actor_ptr>(a));
+  }
+  scoped_actor self;
+  for (auto& a : actors) {
+    self->monitor(a);
+    self->send_exit(a, exit_reason::user_defined);
+  }
+  size_t i = 0;
+  self->receive_for(i, num_actors) (
+    [](const down_msg&) {
+      // nop
+    }
+  );
+  // exited actors are removed from the registry
+  CAF_CHECK_EQUAL(reg->size(), before);
+  for (auto& a : actors) {
+    CAF_CHECK(reg->get(a->id()) == nullptr);
+  }
+  // the most recent exit reasons are still available
+  auto entry = reg->get_entry(actors.back()->id());
+  CAF_CHECK(entry.first == nullptr);
+  CAF_CHECK_EQUAL(entry.second, exit_reason::user_defined);
+  // unknown actors have no exit reason
+  CAF_CHECK_EQUAL(reg->get_entry(reg->next_id()).second, exit_reason::unknown);
+}
+
+void test_concurrent_access() {
+  CAF_PRINT("test_concurrent_access");
+  auto reg = singletons::get_actor_registry();
+  auto before = reg->size();
+  auto a = spawn(dummy);
+  auto ptr = actor_cast<abstract_actor_ptr>(a);
+  reg->put(a->id(), ptr);
+  std::atomic<bool> done{false};
+  std::atomic<bool> ok{true};
+  std::thread reader{[&] {
+    while (!done) {
+      if (reg->get(a->id()) != ptr) {
+        ok = false;
+      }
+    }
+  }};
+  std::vector<actor> actors;
+  for (size_t i = 0; i < num_actors; ++i) {
+    actors.push_back(spawn(dummy));
+    reg->put(actors.back()->id(), actor_cast<abstract_actor_ptr>(actors.back()));
+  }
+  for (auto& x : actors) {
+    reg->erase(x->id(), exit_reason::normal);
+  }
+  done = true;
+  reader.join();
+  CAF_CHECK(ok);
+  CAF_CHECK_EQUAL(reg->size(), before + 1);
+  for (auto& x : actors) {
+    anon_send_exit(x, exit_reason::user_shutdown);
+  }
+  anon_send_exit(a, exit_reason::user_shutdown);
+}
+
+void test_release_retired() {
+  CAF_PRINT("test_release_retired");
+  auto reg = singletons::get_actor_registry();
+  std::vector<actor> actors;
+  for (size_t i = 0; i < num_actors; ++i) {
+    actors.push_back(spawn<counted>());
+  }
+  // exited actors no longer access the registry on their own
+  for (auto& x : actors) {
+    anon_send_exit(x, exit_reason::user_shutdown);
+  }
+  await_all_actors_done();
+  std::vector<actor_id> ids;
+  for (auto& x : actors) {
+    ids.push_back(x->id());
+    reg->put(ids.back(), actor_cast<abstract_actor_ptr>(x));
+  }
+  actors.clear();
+  // keeps each shard busy while its actors leave the registry
+  std::atomic<bool> done{false};
+  std::thread reader{[&] {
+    while (!done) {
+      for (auto id : ids) {
+        reg->get(id);
+      }
+    }
+  }};
+  for (auto id : ids) {
+    reg->erase(id, exit_reason::normal);
+  }
+  done = true;
+  reader.join();
+  // the registry releases all actors without any further write
+  for (int i = 0; i < 100 && s_destroyed != num_actors; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  CAF_CHECK_EQUAL(s_destroyed.load(), num_actors);
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_actor_registry);
+  test_put_and_erase();
+  test_concurrent_access();
+  await_all_actors_done();
+  test_release_retired();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
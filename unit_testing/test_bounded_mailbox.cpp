@@ -0,0 +1,137 @@
+#include "test.hpp"
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr size_t capacity = 10;
+
+void fill(scoped_actor& self, const actor_addr& sender, int first, int last) {
+  auto ptr = actor_cast<abstract_actor_ptr>(self.get()->address());
+  for (int i = first; i < last; ++i) {
+    ptr->enqueue(sender, message_id::make(), make_message(i), nullptr);
+  }
+}
+
+std::vector<int> drain(scoped_actor& self) {
+  std::vector<int> result;
+  bool done = false;
+  self->receive_while([&] { return !done; }) (
+    [&](int x) {
+      result.push_back(x);
+    },
+    after(std::chrono::milliseconds(0)) >> [&] {
+      done = true;
+    }
+  );
+  return result;
+}
+
+std::vector<int> iota(int first, int last) {
+  std::vector<int> result;
+  for (int i = first; i < last; ++i) {
+    result.push_back(i);
+  }
+  return result;
+}
+
+void test_drop_newest() {
+  CAF_PRINT("test_drop_newest");
+  scoped_actor self;
+  self->bound_mailbox(capacity, mailbox_overflow::drop_newest);
+  fill(self, invalid_actor_addr, 0, 2 * capacity);
+  CAF_CHECK_EQUAL(self->mailbox().size(), capacity);
+  // high-priority messages are never discarded
+  self->send(message_priority::high, self, 42);
+  auto xs = drain(self);
+  CAF_CHECK_EQUAL(xs.size(), capacity + 1);
+  CAF_CHECK_EQUAL(xs.back(), 42);
+  xs.pop_back();
+  CAF_CHECK(xs == iota(0, capacity));
+}
+
+void test_drop_oldest() {
+  CAF_PRINT("test_drop_oldest");
+  scoped_actor self;
+  self->bound_mailbox(capacity, mailbox_overflow::drop_oldest);
+  // writers discard new messages once the mailbox holds twice its capacity
+  fill(self, invalid_actor_addr, 0, 3 * capacity);
+  CAF_CHECK_EQUAL(self->mailbox().size(), 2 * capacity);
+  // note: drain() would count its own timeout message as waiting message
+  std::vector<int> xs;
+  size_t i = 0;
+  self->receive_for(i, capacity) (
+    [&](int x) {
+      xs.push_back(x);
+    }
+  );
+  CAF_CHECK(xs == iota(capacity, 2 * capacity));
+  CAF_CHECK_EQUAL(self->mailbox().size(), 0);
+}
+
+void test_reject_requests() {
+  CAF_PRINT("test_reject_requests");
+  scoped_actor self;
+  scoped_actor client;
+  self->bound_mailbox(capacity, mailbox_overflow::reject_requests);
+  fill(self, client->address(), 0, capacity);
+  auto mid = client->new_request_id(message_priority::normal);
+  actor_cast<abstract_actor_ptr>(self.get()->address())
+    ->enqueue(client->address(), mid, make_message(42), nullptr);
+  behavior bhvr{
+    [&](const sync_exited_msg& msg) {
+      CAF_CHECK_EQUAL(msg.reason, exit_reason::mailbox_full);
+    }
+  };
+  client->dequeue(bhvr, mid.response_id());
+  CAF_CHECK(drain(self) == iota(0, capacity));
+}
+
+void test_notify_sender() {
+  CAF_PRINT("test_notify_sender");
+  scoped_actor self;
+  scoped_actor client;
+  self->bound_mailbox(capacity, mailbox_overflow::notify_sender);
+  fill(self, client->address(), 0, capacity + 1);
+  client->receive(
+    [&](mailbox_full_atom) {
+      CAF_CHECK_EQUAL(client->current_sender(), self->address());
+    }
+  );
+  CAF_CHECK(drain(self) == iota(0, capacity));
+}
+
+void test_spawn_bounded() {
+  CAF_PRINT("test_spawn_bounded");
+  scoped_actor self;
+  auto bounds = mailbox_bounds{capacity, mailbox_overflow::drop_newest};
+  auto testee = spawn_bounded(bounds, [](event_based_actor* ptr) -> behavior {
+    return {
+      others >> [=]() -> message {
+        ptr->quit();
+        return make_message(ptr->mailbox_capacity());
+      }
+    };
+  });
+  self->sync_send(testee, 42).await(
+    [](size_t x) {
+      CAF_CHECK_EQUAL(x, capacity);
+    }
+  );
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_bounded_mailbox);
+  test_drop_newest();
+  test_drop_oldest();
+  test_reject_requests();
+  test_notify_sender();
+  test_spawn_bounded();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
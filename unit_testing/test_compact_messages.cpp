@@ -0,0 +1,131 @@
+#include <string>
+#include <memory>
+#include <thread>
+#include <iostream>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using namespace std;
+using namespace caf;
+
+namespace {
+
+using late_atom = atom_constant<atom("late")>;
+
+// announced before the handshake, i.e., sent using a negotiated type ID
+struct early {
+  int32_t value;
+};
+
+bool operator==(const early& lhs, const early& rhs) {
+  return lhs.value == rhs.value;
+}
+
+// announced after the handshake, i.e., sent using type ID 0 and its name
+struct late {
+  string value;
+};
+
+bool operator==(const late& lhs, const late& rhs) {
+  return lhs.value == rhs.value;
+}
+
+void announce_late() {
+  announce<late>("late", &late::value);
+}
+
+behavior server(event_based_actor* self, actor buddy) {
+  auto num_late = make_shared<int>(0);
+  return {
+    [=](late_atom) {
+      announce_late();
+      return ok_atom::value;
+    },
+    [=](const early& x, const string& str, int32_t i) {
+      return make_message(x, str, i);
+    },
+    [=](const late& x, const early& y) {
+      if (++*num_late == 2) {
+        self->send(buddy, ok_atom::value);
+      }
+      return make_message(x, y);
+    }
+  };
+}
+
+void run_client(const char* host, uint16_t port) {
+  auto serv = io::remote_actor(host, port);
+  scoped_actor self;
+  // builtin types and types announced before the handshake
+  self->sync_send(serv, early{42}, string{"hello"}, int32_t{7}).await(
+    [](const early& x, const string& str, int32_t i) {
+      CAF_CHECK_EQUAL(x.value, 42);
+      CAF_CHECK_EQUAL(str, "hello");
+      CAF_CHECK_EQUAL(i, 7);
+    }
+  );
+  // both nodes learn about `late` after the handshake
+  announce_late();
+  self->sync_send(serv, late_atom::value).await(
+    [](ok_atom) {
+      CAF_CHECKPOINT();
+    }
+  );
+  // sent multiple times to cover the cached fallback entry as well
+  for (int i = 0; i < 2; ++i) {
+    self->sync_send(serv, late{"world"}, early{i}).await(
+      [=](const late& x, const early& y) {
+        CAF_CHECK_EQUAL(x.value, "world");
+        CAF_CHECK_EQUAL(y.value, i);
+      }
+    );
+  }
+  anon_send_exit(serv, exit_reason::user_shutdown);
+}
+
+void test_compact_messages(const char* app_path) {
+  CAF_PRINT("test_compact_messages");
+  scoped_actor self;
+  actor buddy = self;
+  auto port = io::publish(spawn(server, buddy), 0, "127.0.0.1");
+  CAF_CHECK(port > 0);
+  auto child = run_program(self, app_path, "-c", port);
+  self->receive(
+    [](ok_atom) {
+      CAF_CHECKPOINT();
+    },
+    after(chrono::seconds(10)) >> [] {
+      CAF_UNEXPECTED_TOUT();
+    }
+  );
+  child.join();
+  self->await_all_other_actors_done();
+  self->receive(
+    [](const string& output) {
+      cout << endl << endl << "*** output of client program ***"
+           << endl << output << endl;
+    }
+  );
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  CAF_TEST(test_compact_messages);
+  announce<early>("early", &early::value);
+  message_builder{argv + 1, argv + argc}.apply({
+    on("-c", spro<uint16_t>) >> [](uint16_t port) {
+      CAF_PRINT("run in client mode");
+      run_client("localhost", port);
+    },
+    on() >> [&] {
+      test_compact_messages(argv[0]);
+    }
+  });
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
@@ -0,0 +1,139 @@
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <fstream>
+
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/detail/cpu_topology.hpp"
+
+using namespace caf;
+
+namespace {
+
+// creates a fake sysfs tree and removes it on destruction
+class fake_sysfs {
+ public:
+  fake_sysfs(std::string root) : m_root(std::move(root)) {
+    mkdirs(m_root);
+  }
+
+  ~fake_sysfs() {
+    for (auto i = m_files.rbegin(); i != m_files.rend(); ++i) {
+      std::remove(i->c_str());
+    }
+    for (auto i = m_dirs.rbegin(); i != m_dirs.rend(); ++i) {
+      rmdir(i->c_str());
+    }
+  }
+
+  void put(const std::string& path, const std::string& content) {
+    auto pos = path.rfind('/');
+    if (pos != std::string::npos) {
+      mkdirs(m_root + "/" + path.substr(0, pos));
+    }
+    auto full_path = m_root + "/" + path;
+    std::ofstream out{full_path};
+    out << content << "\n";
+    m_files.push_back(full_path);
+  }
+
+  const std::string& root() const {
+    return m_root;
+  }
+
+ private:
+  void mkdirs(const std::string& path) {
+    size_t pos = 0;
+    do {
+      pos = path.find('/', pos + 1);
+      auto dir = path.substr(0, pos);
+      if (mkdir(dir.c_str(), 0755) == 0) {
+        m_dirs.push_back(dir);
+      }
+    } while (pos != std::string::npos);
+  }
+
+  std::string m_root;
+  std::vector<std::string> m_dirs;
+  std::vector<std::string> m_files;
+};
+
+void test_read() {
+  CAF_PRINT("test_read");
+  // two NUMA nodes with two cores each and two SMT threads per core
+  fake_sysfs fs{"test_cpu_topology_sysfs"};
+  fs.put("cpu/online", "0-7");
+  for (int i = 0; i < 8; ++i) {
+    auto dir = "cpu/cpu" + std::to_string(i) + "/topology/";
+    fs.put(dir + "core_id", std::to_string(i % 2));
+    fs.put(dir + "physical_package_id", std::to_string(i / 4));
+  }
+  fs.put("node/online", "0-1");
+  fs.put("node/node0/cpulist", "0-3");
+  fs.put("node/node1/cpulist", "4-7");
+  auto topology = detail::cpu_topology::read(fs.root());
+  std::vector<int> ids;
+  for (auto& cpu : topology.cpus()) {
+    ids.push_back(cpu.id);
+  }
+  // one thread per core before using SMT siblings
+  CAF_CHECK((ids == std::vector<int>{0, 1, 4, 5, 2, 3, 6, 7}));
+  CAF_CHECK_EQUAL(topology.placement(2)->node, 1);
+  CAF_CHECK_EQUAL(topology.placement(8)->id, 0);
+  auto tiers = topology.steal_tiers(0, 8);
+  CAF_CHECK_EQUAL(tiers.size(), 3);
+  CAF_CHECK((tiers[0] == std::vector<size_t>{4}));
+  CAF_CHECK((tiers[1] == std::vector<size_t>{1, 5}));
+  CAF_CHECK((tiers[2] == std::vector<size_t>{2, 3, 6, 7}));
+  // CPUs outside of the affinity mask are never used
+  auto restricted = detail::cpu_topology::read(fs.root(), {1, 5, 6});
+  ids.clear();
+  for (auto& cpu : restricted.cpus()) {
+    ids.push_back(cpu.id);
+  }
+  CAF_CHECK((ids == std::vector<int>{1, 6, 5}));
+}
+
+void test_missing_sysfs() {
+  CAF_PRINT("test_missing_sysfs");
+  auto topology = detail::cpu_topology::read("test_cpu_topology_missing");
+  CAF_CHECK(topology.empty());
+  CAF_CHECK(topology.placement(0) == nullptr);
+  CAF_CHECK_EQUAL(topology.steal_tiers(0, 4)[2].size(), 3);
+}
+
+behavior ping(event_based_actor* self, int num_pings) {
+  return {
+    [=](int x) {
+      if (x >= num_pings) {
+        self->quit();
+      }
+      return x + 1;
+    }
+  };
+}
+
+void test_pinned_workers() {
+  CAF_PRINT("test_pinned_workers");
+  auto a = spawn(ping, 1000);
+  auto b = spawn(ping, 1000);
+  send_as(b, a, 1);
+  await_all_actors_done();
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_cpu_topology);
+  test_read();
+  test_missing_sysfs();
+  policy::work_stealing::set_worker_pinning(true);
+  test_pinned_workers();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
@@ -0,0 +1,79 @@
+#include <atomic>
+#include <thread>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/detail/event_count.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr size_t num_events = 10000;
+
+void test_no_lost_wakeups() {
+  CAF_PRINT("test_no_lost_wakeups");
+  detail::event_count ec;
+  std::atomic<size_t> produced{0};
+  size_t consumed = 0;
+  std::thread consumer{[&] {
+    while (consumed < num_events) {
+      if (produced.load() > consumed) {
+        ++consumed;
+        continue;
+      }
+      auto key = ec.prepare_wait();
+      if (produced.load() > consumed) {
+        ec.cancel_wait();
+        continue;
+      }
+      ec.wait(key);
+    }
+  }};
+  for (size_t i = 0; i < num_events; ++i) {
+    ++produced;
+    ec.notify_one();
+  }
+  consumer.join();
+  CAF_CHECK_EQUAL(consumed, num_events);
+}
+
+behavior ping(event_based_actor* self, int num_pings) {
+  return {
+    [=](int x) {
+      if (x >= num_pings) {
+        self->quit();
+      }
+      return x + 1;
+    }
+  };
+}
+
+void test_parked_workers() {
+  CAF_PRINT("test_parked_workers");
+  // idle workers park right away, i.e., each message needs a wakeup
+  auto a = spawn(ping, 1000);
+  auto b = spawn(ping, 1000);
+  send_as(b, a, 1);
+  await_all_actors_done();
+  scoped_actor self;
+  auto c = spawn(ping, 0);
+  self->sync_send(c, 41).await(
+    [](int x) {
+      CAF_CHECK_EQUAL(x, 42);
+    }
+  );
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_event_count);
+  test_no_lost_wakeups();
+  policy::work_stealing::set_spin_attempts(0);
+  test_parked_workers();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
@@ -0,0 +1,147 @@
+#include <atomic>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/detail/logging.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr int num_pings = 2000;
+
+struct plain {
+  int value;
+};
+
+std::ostream& operator<<(std::ostream& out, const plain& x) {
+  return out << x.value;
+}
+
+struct nested {
+  int value;
+};
+
+std::ostream& operator<<(std::ostream& out, const nested& x) {
+  // builds a message while the outer message is not yet complete
+  return out << (detail::oss_wr{} << "nested(" << x.value << ")").str();
+}
+
+void test_format() {
+  CAF_PRINT("test_format");
+  std::string str = (detail::oss_wr{} << "x = " << 42 << ", y = " << -7
+                                       << ", z = " << 1.5 << ", b = " << true
+                                       << ", c = " << 'c' << ", u = "
+                                       << std::numeric_limits<uint64_t>::max()
+                                       << ", n = " << nested{3}
+                                       << ", s = " << std::string{"str"}).str();
+  CAF_CHECK_EQUAL(str, "x = 42, y = -7, z = 1.5, b = true, c = c, "
+                       "u = 18446744073709551615, n = nested(3), s = str");
+  // manipulators apply to builtin types as well
+  str = (detail::oss_wr{} << std::hex << 255 << " " << 10u << std::dec
+                          << " " << 10).str();
+  CAF_CHECK_EQUAL(str, "ff a 10");
+  str = (detail::oss_wr{} << std::setprecision(3) << 3.14159 << " "
+                          << std::noboolalpha << true).str();
+  CAF_CHECK_EQUAL(str, "3.14 1");
+  str = (detail::oss_wr{} << std::setw(3) << 7 << "," << 8 << std::endl).str();
+  CAF_CHECK_EQUAL(str, "  7,8\n");
+  // manipulators do not leak into the next message
+  str = (detail::oss_wr{} << std::hex << plain{10}).str();
+  CAF_CHECK_EQUAL(str, "a");
+  str = (detail::oss_wr{} << plain{10} << " " << 10 << " " << 1.5).str();
+  CAF_CHECK_EQUAL(str, "10 10 1.5");
+}
+
+void log_seq(const char* fun_name, int seq) {
+  detail::singletons::get_logger()->log("INFO ", "test_logging", fun_name,
+                                        __FILE__, __LINE__,
+                                        (detail::oss_wr{} << "seq = " << seq)
+                                        .str());
+}
+
+// returns the name of the log file of this process
+std::string log_file_name() {
+  auto prefix = "actor_log_" + std::to_string(getpid()) + "_";
+  std::string result;
+  auto dir = opendir(".");
+  if (dir == nullptr) {
+    return result;
+  }
+  while (auto entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name.compare(0, prefix.size(), prefix) == 0) {
+      result = name;
+    }
+  }
+  closedir(dir);
+  return result;
+}
+
+// two threads log alternately, i.e., each record happens before the next
+void log_ping_pong() {
+  CAF_PRINT("log_ping_pong");
+  std::atomic<int> turn{0};
+  auto player = [&](const char* fun_name, int parity) {
+    for (int i = parity; i < num_pings; i += 2) {
+      while (turn.load() != i) {
+        std::this_thread::yield();
+      }
+      log_seq(fun_name, i);
+      turn = i + 1;
+    }
+  };
+  std::thread ping{player, "ping", 0};
+  std::thread pong{player, "pong", 1};
+  ping.join();
+  pong.join();
+}
+
+void check_log_order(const std::string& file_name) {
+  CAF_PRINT("check_log_order");
+  std::ifstream in{file_name};
+  std::string line;
+  std::string key = "seq = ";
+  int expected = 0;
+  while (std::getline(in, line)) {
+    auto pos = line.find(key);
+    if (pos == std::string::npos) {
+      continue;
+    }
+    auto seq = std::stoi(line.substr(pos + key.size()));
+    if (seq != expected) {
+      CAF_FAILURE("expected seq = " << expected << ", found: " << seq);
+      return;
+    }
+    ++expected;
+  }
+  CAF_CHECK_EQUAL(expected, num_pings);
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_logging);
+  test_format();
+  log_ping_pong();
+  // stops the logger, which writes all pending records
+  shutdown();
+  auto file_name = log_file_name();
+  CAF_CHECK(!file_name.empty());
+  if (!file_name.empty()) {
+    check_log_order(file_name);
+    std::remove(file_name.c_str());
+  }
+  return CAF_TEST_RESULT();
+}
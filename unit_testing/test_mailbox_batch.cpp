@@ -0,0 +1,98 @@
+#include "test.hpp"
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr int num_messages = 1000;
+
+mailbox_batch make_batch(const actor_addr& sender, int first, int last) {
+  mailbox_batch result;
+  for (int i = first; i < last; ++i) {
+    result.push_back(mailbox_element::make(sender, message_id::make(),
+                                           make_message(i)));
+  }
+  return result;
+}
+
+void test_event_based_receiver() {
+  CAF_PRINT("test_event_based_receiver");
+  scoped_actor self;
+  auto testee = spawn([](event_based_actor* ptr) -> behavior {
+    auto expected = std::make_shared<int>(0);
+    return {
+      [=](int x) {
+        if (x != *expected) {
+          CAF_FAILURE("expected " << *expected << ", found " << x);
+        }
+        if (++*expected == num_messages) {
+          ptr->quit();
+        }
+      }
+    };
+  });
+  auto ptr = actor_cast<abstract_actor_ptr>(testee);
+  auto batch = make_batch(self->address(), 0, num_messages / 2);
+  CAF_CHECK_EQUAL(batch.size(), num_messages / 2);
+  ptr->enqueue_batch(std::move(batch), nullptr);
+  ptr->enqueue_batch(make_batch(self->address(), num_messages / 2,
+                                num_messages),
+                     nullptr);
+  self->await_all_other_actors_done();
+}
+
+void test_blocking_receiver() {
+  CAF_PRINT("test_blocking_receiver");
+  scoped_actor self;
+  auto ptr = actor_cast<abstract_actor_ptr>(self.get()->address());
+  ptr->enqueue_batch(make_batch(invalid_actor_addr, 0, num_messages), nullptr);
+  int i = 0;
+  bool in_order = true;
+  self->receive_for(i, num_messages) (
+    [&](int x) {
+      in_order = in_order && x == i;
+    }
+  );
+  CAF_CHECK(in_order);
+}
+
+void test_closed_mailbox() {
+  CAF_PRINT("test_closed_mailbox");
+  scoped_actor self;
+  auto testee = spawn([](event_based_actor* ptr) {
+    ptr->quit();
+  });
+  self->monitor(testee);
+  self->receive(
+    [](const down_msg&) {
+      CAF_CHECKPOINT();
+    }
+  );
+  // sync requests to a dead actor must be bounced
+  mailbox_batch batch;
+  auto mid = self->new_request_id(message_priority::normal);
+  batch.push_back(mailbox_element::make(self->address(), mid,
+                                        make_message(42)));
+  actor_cast<abstract_actor_ptr>(testee)->enqueue_batch(std::move(batch),
+                                                        nullptr);
+  behavior bhvr{
+    [&](const sync_exited_msg& msg) {
+      CAF_CHECK_EQUAL(msg.reason, exit_reason::normal);
+    }
+  };
+  self->dequeue(bhvr, mid.response_id());
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_mailbox_batch);
+  test_event_based_receiver();
+  test_blocking_receiver();
+  test_closed_mailbox();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
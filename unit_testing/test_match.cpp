@@ -174,11 +174,71 @@ void test_arg_match() {
   CAF_CHECK_EQUAL(invoked(expr3, wrapped_int{42}, wrapped_int{1}), 0);
 }
 
+void test_dispatch_table() {
+  // large behaviors dispatch via table, which must not change the
+  // order in which cases are tried, including cases with wildcards
+  int last = -1;
+  message_handler expr{
+    on(hi_atom::value, 1) >> [&] {
+      last = 0;
+    },
+    [&](ho_atom, int) {
+      last = 1;
+    },
+    on(42, any_vals) >> [&] {
+      last = 2;
+    },
+    [&](hi_atom, int) {
+      last = 3;
+    },
+    [&](atom_value, int) {
+      last = 4;
+    },
+    [&](int) {
+      last = 5;
+    },
+    [&](const string&) {
+      last = 6;
+    },
+    [&](double) {
+      last = 7;
+    },
+    on(ok_atom::value) >> [&] {
+      last = 8;
+    },
+    others >> [&] {
+      last = 9;
+    }
+  };
+  auto invoke = [&](message msg) {
+    last = -1;
+    expr(msg);
+    return last;
+  };
+  CAF_CHECK_EQUAL(invoke(make_message(hi_atom::value, 1)), 0);
+  CAF_CHECK_EQUAL(invoke(make_message(hi_atom::value, 2)), 3);
+  CAF_CHECK_EQUAL(invoke(make_message(hi_atom::value, 42)), 3);
+  CAF_CHECK_EQUAL(invoke(make_message(ho_atom::value, 5)), 1);
+  CAF_CHECK_EQUAL(invoke(make_message(ho_atom::value, 42)), 1);
+  CAF_CHECK_EQUAL(invoke(make_message(ok_atom::value, 7)), 4);
+  CAF_CHECK_EQUAL(invoke(make_message(ok_atom::value)), 8);
+  CAF_CHECK_EQUAL(invoke(make_message(hi_atom::value)), 9);
+  CAF_CHECK_EQUAL(invoke(make_message(42)), 2);
+  CAF_CHECK_EQUAL(invoke(make_message(42, "a")), 2);
+  CAF_CHECK_EQUAL(invoke(make_message(3)), 5);
+  CAF_CHECK_EQUAL(invoke(make_message("a")), 6);
+  CAF_CHECK_EQUAL(invoke(make_message(1.0)), 7);
+  CAF_CHECK_EQUAL(invoke(make_message(1, 2, 3)), 9);
+  // the type token only covers the last elements of long messages
+  CAF_CHECK_EQUAL(invoke(make_message(1, 2, 3, 4, 5, 6, hi_atom::value, 1)), 9);
+}
+
 int main() {
   CAF_TEST(test_match);
   test_atoms();
   test_custom_projections();
   test_arg_match();
+  test_dispatch_table();
   shutdown();
   return CAF_TEST_RESULT();
 }
@@ -0,0 +1,71 @@
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/detail/memory.hpp"
+
+using namespace caf;
+
+using detail::memory;
+
+namespace {
+
+constexpr size_t num_elements = 100;
+
+using element_vector = std::vector<mailbox_element_ptr>;
+
+element_vector make_elements() {
+  element_vector result;
+  for (size_t i = 0; i < num_elements; ++i) {
+    result.push_back(mailbox_element::make(invalid_actor_addr,
+                                           message_id::make(),
+                                           make_message(i)));
+  }
+  return result;
+}
+
+void test_local_release() {
+  CAF_PRINT("test_local_release");
+  auto before = memory::stats<mailbox_element>();
+  auto xs = make_elements();
+  CAF_CHECK_EQUAL(memory::stats<mailbox_element>().live_objects,
+                  before.live_objects + num_elements);
+  xs.clear();
+  auto after = memory::stats<mailbox_element>();
+  CAF_CHECK_EQUAL(after.live_objects, before.live_objects);
+  CAF_CHECK(after.retained_bytes > before.retained_bytes);
+  // freed blocks are recycled instead of allocating new memory
+  auto ys = make_elements();
+  CAF_CHECK_EQUAL(memory::stats<mailbox_element>().retained_bytes,
+                  before.retained_bytes);
+}
+
+void test_remote_release() {
+  CAF_PRINT("test_remote_release");
+  auto before = memory::stats<mailbox_element>();
+  auto xs = make_elements();
+  std::thread t{[&] {
+    xs.clear();
+  }};
+  t.join();
+  CAF_CHECK(xs.empty());
+  CAF_CHECK_EQUAL(memory::stats<mailbox_element>().live_objects,
+                  before.live_objects);
+  // blocks returned by the other thread are available to this thread again
+  auto ys = make_elements();
+  ys.clear();
+  CAF_CHECK(memory::stats<mailbox_element>().retained_bytes
+            >= before.retained_bytes);
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_memory);
+  test_local_release();
+  test_remote_release();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
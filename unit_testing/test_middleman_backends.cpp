@@ -0,0 +1,186 @@
+#include <set>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <cstring>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using namespace caf;
+using namespace caf::io;
+
+namespace {
+
+constexpr size_t num_backends = 4;
+
+constexpr char payload[] = "hello world";
+
+constexpr size_t payload_size = sizeof(payload);
+
+bool in_own_loop(broker* self) {
+  return std::this_thread::get_id() == self->backend().thread_id();
+}
+
+behavior echo_server(broker* self, actor buddy) {
+  auto port = self->add_tcp_doorman(0, "127.0.0.1").second;
+  anon_send(buddy, port);
+  return {
+    [=](const new_connection_msg& msg) {
+      CAF_CHECK(in_own_loop(self));
+      self->configure_read(msg.handle, receive_policy::exactly(payload_size));
+    },
+    [=](const new_data_msg& msg) {
+      CAF_CHECK(in_own_loop(self));
+      self->write(msg.handle, msg.buf.size(), msg.buf.data());
+      self->flush(msg.handle);
+    },
+    [=](const connection_closed_msg&) {
+      self->quit();
+    }
+  };
+}
+
+behavior echo_client(broker* self, connection_handle hdl, actor buddy) {
+  self->configure_read(hdl, receive_policy::exactly(payload_size));
+  self->write(hdl, payload_size, payload);
+  self->flush(hdl);
+  return {
+    [=](const new_data_msg& msg) {
+      CAF_CHECK(in_own_loop(self));
+      auto ok = memcmp(msg.buf.data(), payload, payload_size) == 0;
+      anon_send(buddy, ok, reinterpret_cast<intptr_t>(&self->backend()));
+      self->quit();
+    }
+  };
+}
+
+void test_distribution() {
+  CAF_PRINT("test_distribution");
+  CAF_CHECK_EQUAL(middleman::instance()->num_backends(), num_backends);
+  scoped_actor self;
+  std::set<intptr_t> backends;
+  std::vector<actor> brokers;
+  for (size_t i = 0; i < num_backends; ++i) {
+    // brokers stay alive, because the load of a loop is its number of brokers
+    auto b = spawn_io([](broker* ptr) -> behavior {
+      return {
+        others >> [=] {
+          CAF_CHECK(in_own_loop(ptr));
+          return reinterpret_cast<intptr_t>(&ptr->backend());
+        }
+      };
+    });
+    self->sync_send(b, ok_atom::value).await(
+      [&](intptr_t x) {
+        backends.insert(x);
+      }
+    );
+    brokers.push_back(b);
+  }
+  // the BASP broker runs in the default loop, i.e., the least-loaded
+  // policy assigns the default loop to our last broker
+  CAF_CHECK_EQUAL(backends.size(), num_backends);
+  for (auto& b : brokers) {
+    self->send_exit(b, exit_reason::user_shutdown);
+  }
+}
+
+void test_echo() {
+  CAF_PRINT("test_echo");
+  scoped_actor self;
+  actor buddy = self;
+  spawn_io(echo_server, buddy);
+  self->receive(
+    [&](uint16_t port) {
+      spawn_io_client(echo_client, "127.0.0.1", port, buddy);
+    }
+  );
+  self->receive(
+    [&](bool ok, intptr_t) {
+      CAF_CHECK(ok);
+    }
+  );
+  self->await_all_other_actors_done();
+}
+
+behavior echo_worker(broker* self, connection_handle hdl, actor buddy) {
+  self->configure_read(hdl, receive_policy::exactly(payload_size));
+  return {
+    [=](const new_data_msg& msg) {
+      CAF_CHECK(in_own_loop(self));
+      anon_send(buddy, reinterpret_cast<intptr_t>(&self->backend()));
+      self->write(msg.handle, msg.buf.size(), msg.buf.data());
+      self->flush(msg.handle);
+    },
+    [=](const connection_closed_msg&) {
+      // stay alive, because the load of a loop is its number of brokers
+    },
+    [=](ok_atom) {
+      self->quit();
+    }
+  };
+}
+
+behavior forking_server(broker* self, actor buddy) {
+  auto port = self->add_tcp_doorman(0, "127.0.0.1").second;
+  anon_send(buddy, port);
+  auto workers = std::make_shared<std::vector<actor>>();
+  return {
+    [=](const new_connection_msg& msg) {
+      workers->push_back(self->fork(echo_worker, msg.handle, buddy));
+    },
+    [=](ok_atom) {
+      for (auto& worker : *workers) {
+        self->send(worker, ok_atom::value);
+      }
+      self->quit();
+    }
+  };
+}
+
+void test_fork_distribution() {
+  CAF_PRINT("test_fork_distribution");
+  scoped_actor self;
+  actor buddy = self;
+  auto server = spawn_io(forking_server, buddy);
+  uint16_t port = 0;
+  self->receive(
+    [&](uint16_t x) {
+      port = x;
+    }
+  );
+  // each worker reports its loop, each client reports its echo
+  std::set<intptr_t> backends;
+  for (size_t i = 0; i < num_backends; ++i) {
+    spawn_io_client(echo_client, "127.0.0.1", port, buddy);
+  }
+  size_t i = 0;
+  self->receive_for(i, 2 * num_backends) (
+    [&](intptr_t x) {
+      backends.insert(x);
+    },
+    [&](bool ok, intptr_t) {
+      CAF_CHECK(ok);
+    }
+  );
+  // forked brokers no longer share the event loop of their parent
+  CAF_CHECK(backends.size() > 1);
+  self->send(server, ok_atom::value);
+  self->await_all_other_actors_done();
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_middleman_backends);
+  middleman::set_num_backends(num_backends);
+  test_distribution();
+  test_echo();
+  test_fork_distribution();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
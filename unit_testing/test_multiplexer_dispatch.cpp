@@ -0,0 +1,60 @@
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr int num_threads = 4;
+constexpr int num_runnables = 10000;
+
+void test_concurrent_post() {
+  CAF_PRINT("test_concurrent_post");
+  scoped_actor self;
+  auto& mpx = io::middleman::instance()->backend();
+  // only accessed from the multiplexer thread
+  auto last_seen = std::make_shared<std::vector<int>>(num_threads, -1);
+  auto total = std::make_shared<int>(0);
+  auto in_order = std::make_shared<bool>(true);
+  actor receiver = self;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([=, &mpx] {
+      for (int i = 0; i < num_runnables; ++i) {
+        mpx.post([=] {
+          auto& last = (*last_seen)[static_cast<size_t>(t)];
+          if (last + 1 != i) {
+            *in_order = false;
+          }
+          last = i;
+          if (++*total == num_threads * num_runnables) {
+            anon_send(receiver, *in_order);
+          }
+        });
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  self->receive(
+    [](bool fifo) {
+      CAF_CHECK(fifo);
+    }
+  );
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_multiplexer_dispatch);
+  test_concurrent_post();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
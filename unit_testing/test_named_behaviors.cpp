@@ -0,0 +1,121 @@
+#include "test.hpp"
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+using flip_atom = atom_constant<atom("flip")>;
+using get_atom = atom_constant<atom("get")>;
+using push_atom = atom_constant<atom("push")>;
+using pop_atom = atom_constant<atom("pop")>;
+using redefine_atom = atom_constant<atom("redefine")>;
+
+constexpr int num_transitions = 10000;
+
+enum state : size_t {
+  on_state,
+  off_state,
+  paused_state
+};
+
+class switch_actor : public event_based_actor {
+ public:
+  switch_actor() : m_transitions(0) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    set_behavior(on_state, {
+      [=](flip_atom) {
+        ++m_transitions;
+        become(named_behavior(off_state));
+      },
+      [=](get_atom) {
+        return make_message(atom("on"), m_transitions, unique());
+      },
+      [=](push_atom) {
+        become(keep_behavior, named_behavior(paused_state));
+      },
+      [=](redefine_atom) {
+        // replaces the running behavior
+        set_behavior(on_state, {
+          [=](get_atom) {
+            return make_message(atom("redefined"), m_transitions, unique());
+          }
+        });
+      }
+    });
+    set_behavior(off_state, {
+      [=](flip_atom) {
+        ++m_transitions;
+        become(named_behavior(on_state));
+      },
+      [=](get_atom) {
+        return make_message(atom("off"), m_transitions, unique());
+      }
+    });
+    set_behavior(paused_state, {
+      [=](pop_atom) {
+        unbecome();
+      },
+      [=](get_atom) {
+        return make_message(atom("paused"), m_transitions, unique());
+      }
+    });
+    become(named_behavior(on_state));
+    return {};
+  }
+
+ private:
+  // named behaviors are not shared with the behavior stack
+  bool unique() {
+    return get_behavior().as_behavior_impl()->unique();
+  }
+
+  int m_transitions;
+};
+
+void expect(scoped_actor& self, const actor& testee, atom_value state,
+            int transitions) {
+  self->sync_send(testee, get_atom::value).await(
+    [&](atom_value x, int y, bool unique) {
+      CAF_CHECK_EQUAL(to_string(x), to_string(state));
+      CAF_CHECK_EQUAL(y, transitions);
+      CAF_CHECK(unique);
+    }
+  );
+}
+
+void test_named_behaviors() {
+  CAF_PRINT("test_named_behaviors");
+  scoped_actor self;
+  auto testee = spawn<switch_actor>();
+  expect(self, testee, atom("on"), 0);
+  for (int i = 0; i < num_transitions; ++i) {
+    self->send(testee, flip_atom::value);
+  }
+  expect(self, testee, atom("on"), num_transitions);
+  self->send(testee, flip_atom::value);
+  expect(self, testee, atom("off"), num_transitions + 1);
+  self->send(testee, flip_atom::value);
+  self->send(testee, push_atom::value);
+  expect(self, testee, atom("paused"), num_transitions + 2);
+  self->send(testee, pop_atom::value);
+  expect(self, testee, atom("on"), num_transitions + 2);
+  self->send(testee, redefine_atom::value);
+  expect(self, testee, atom("redefined"), num_transitions + 2);
+  self->send_exit(testee, exit_reason::user_shutdown);
+  self->await_all_other_actors_done();
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_named_behaviors);
+  test_named_behaviors();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
@@ -0,0 +1,115 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/detail/pending_table.hpp"
+
+using namespace caf;
+
+using detail::pending_table;
+
+namespace {
+
+constexpr uint64_t num_entries = 10000;
+
+message_id mid(uint64_t x) {
+  return message_id::from_integer_value(x).response_id();
+}
+
+void test_insert_and_erase() {
+  CAF_PRINT("test_insert_and_erase");
+  pending_table<std::string> xs;
+  CAF_CHECK(xs.empty());
+  for (uint64_t i = 1; i <= num_entries; ++i) {
+    xs.push_front(std::make_pair(mid(i), std::to_string(i)));
+  }
+  CAF_CHECK_EQUAL(xs.size(), num_entries);
+  CAF_CHECK(xs.front().first == mid(num_entries));
+  // references remain valid while inserting
+  auto& first = *xs.find(mid(1));
+  CAF_CHECK_EQUAL(first.second, "1");
+  // erase every other entry
+  for (uint64_t i = 2; i <= num_entries; i += 2) {
+    CAF_CHECK(xs.erase(mid(i)));
+  }
+  CAF_CHECK(!xs.erase(mid(2)));
+  CAF_CHECK_EQUAL(xs.size(), num_entries / 2);
+  CAF_CHECK_EQUAL(first.second, "1");
+  size_t found = 0;
+  for (uint64_t i = 1; i <= num_entries; ++i) {
+    auto ptr = xs.find(mid(i));
+    if (i % 2 == 1 && ptr && ptr->second == std::to_string(i)) {
+      ++found;
+    } else if (i % 2 == 0 && ptr) {
+      CAF_FAILURE("found erased entry " << i);
+    }
+  }
+  CAF_CHECK_EQUAL(found, num_entries / 2);
+  // the most recent remaining entry is the new front
+  CAF_CHECK(xs.front().first == mid(num_entries - 1));
+  std::vector<std::string> removed;
+  xs.remove_if([](const std::pair<message_id, std::string>& x) {
+                 return x.second.size() < 4;
+               },
+               [&](const std::pair<message_id, std::string>& x) {
+                 removed.push_back(x.second);
+               });
+  // removes 1, 3, ..., 999
+  CAF_CHECK_EQUAL(removed.size(), 500);
+  CAF_CHECK_EQUAL(xs.size(), num_entries / 2 - 500);
+  CAF_CHECK(xs.find(mid(999)) == nullptr);
+  CAF_CHECK(xs.find(mid(1001)) != nullptr);
+  xs.clear();
+  CAF_CHECK(xs.empty());
+}
+
+void test_many_pending_requests() {
+  CAF_PRINT("test_many_pending_requests");
+  scoped_actor self;
+  actor buddy = self;
+  auto server = spawn([](event_based_actor* ptr) -> behavior {
+    return {
+      [=](int x) {
+        if (x < 0) {
+          ptr->quit();
+        }
+        return x;
+      }
+    };
+  });
+  spawn([=](event_based_actor* ptr) {
+    auto sum = std::make_shared<uint64_t>(0);
+    auto pending = std::make_shared<uint64_t>(num_entries);
+    // all requests are in flight before the first response arrives
+    for (uint64_t i = 0; i < num_entries; ++i) {
+      ptr->sync_send(server, static_cast<int>(i)).then(
+        [=](int x) {
+          *sum += static_cast<uint64_t>(x);
+          if (--*pending == 0) {
+            ptr->send(buddy, *sum);
+            ptr->send(server, -1);
+          }
+        }
+      );
+    }
+  });
+  self->receive(
+    [](uint64_t sum) {
+      CAF_CHECK_EQUAL(sum, num_entries * (num_entries - 1) / 2);
+    }
+  );
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_pending_table);
+  test_insert_and_erase();
+  test_many_pending_requests();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
@@ -0,0 +1,133 @@
+#include <future>
+#include <vector>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+
+#include "caf/detail/single_reader_queue.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr int num_messages = 100;
+
+// collects all integers and reports them once it receives `done`
+behavior collector(event_based_actor* self, actor buddy) {
+  auto xs = std::make_shared<std::vector<int>>();
+  return {
+    [=](int x) {
+      xs->push_back(x);
+    },
+    on(atom("done")) >> [=] {
+      self->send(buddy, *xs);
+      self->quit();
+    }
+  };
+}
+
+template <spawn_options Os>
+void test_order(const char* name) {
+  CAF_PRINT(name);
+  scoped_actor self;
+  // the testee blocks in its first handler until all messages below
+  // are in its mailbox, i.e., it never skips any of them
+  std::promise<void> filled;
+  auto barrier = filled.get_future().share();
+  auto testee = spawn<Os>([=](event_based_actor* ptr, actor buddy) -> behavior {
+    return {
+      on(atom("wait")) >> [=] {
+        barrier.wait();
+        ptr->become(collector(ptr, buddy));
+      }
+    };
+  }, self);
+  // `wait` uses the high priority lane as well to make sure it is
+  // the first message the testee dequeues
+  self->send(message_priority::high, testee, atom("wait"));
+  for (int i = 0; i < num_messages; ++i) {
+    self->send(testee, i);
+    self->send(message_priority::high, testee, num_messages + i);
+  }
+  for (int i = 0; i < num_messages; ++i) {
+    self->send(message_priority::high, testee, 2 * num_messages + i);
+  }
+  self->send(testee, atom("done"));
+  filled.set_value();
+  self->receive(
+    [&](const std::vector<int>& xs) {
+      CAF_CHECK_EQUAL(xs.size(), 3u * num_messages);
+      // high priority messages come first and keep their order
+      std::vector<int> expected;
+      for (int i = num_messages; i < 3 * num_messages; ++i) {
+        expected.push_back(i);
+      }
+      for (int i = 0; i < num_messages; ++i) {
+        expected.push_back(i);
+      }
+      CAF_CHECK(xs == expected);
+    }
+  );
+  self->await_all_other_actors_done();
+}
+
+void test_wakeup() {
+  CAF_PRINT("test_wakeup");
+  // a blocked reader must wake up for messages on the high priority lane
+  scoped_actor self;
+  auto testee = spawn<priority_aware + blocking_api>([](blocking_actor* ptr) {
+    for (int i = 0; i < num_messages; ++i) {
+      ptr->receive(
+        [](int x) {
+          return x;
+        }
+      );
+    }
+  });
+  for (int i = 0; i < num_messages; ++i) {
+    self->send(message_priority::high, testee, i);
+    self->receive(
+      [&](int x) {
+        CAF_CHECK_EQUAL(x, i);
+      }
+    );
+  }
+  self->await_all_other_actors_done();
+}
+
+struct node {
+  node(int x = 0) : value(x), next(nullptr), prev(nullptr) {
+    // nop
+  }
+  int value;
+  node* next;
+  node* prev;
+};
+
+void test_closed_queue() {
+  CAF_PRINT("test_closed_queue");
+  detail::single_reader_queue<node> q;
+  q.enqueue(new node(1));
+  q.enqueue_high(new node(2));
+  CAF_CHECK_EQUAL(q.count(), 2u);
+  q.close();
+  // the closed high priority lane must not appear as element
+  CAF_CHECK_EQUAL(q.count(), 0u);
+  CAF_CHECK(q.try_pop() == nullptr);
+  CAF_CHECK(q.enqueue_high(new node(3))
+            == detail::enqueue_result::queue_closed);
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_priority_mailbox);
+  test_order<priority_aware>("test_order");
+  test_order<priority_aware + detached>("test_order_detached");
+  test_wakeup();
+  test_closed_queue();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
@@ -0,0 +1,132 @@
+#include <string>
+#include <vector>
+#include <thread>
+#include <iostream>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+#include "caf/forwarding_actor_proxy.hpp"
+
+using namespace std;
+using namespace caf;
+
+namespace {
+
+using actor_vector = vector<actor>;
+
+constexpr size_t num_receivers = 3;
+
+// runs on the client node and reports the multicast message to its sender
+behavior receiver(event_based_actor* self) {
+  return {
+    [=](const string& str, int value) {
+      auto sender = actor_cast<actor>(self->current_sender());
+      CAF_CHECK(sender != invalid_actor);
+      self->send(sender, ok_atom::value, str, value);
+      self->quit();
+    }
+  };
+}
+
+// runs on the server node and sends one message to all receivers of the
+// client node using a single multicast frame
+behavior collector(event_based_actor* self, actor buddy) {
+  auto replies = make_shared<size_t>(0);
+  return {
+    [=](const actor_vector& xs) {
+      CAF_CHECK_EQUAL(xs.size(), num_receivers);
+      vector<actor_addr> receivers;
+      for (auto& x : xs) {
+        CAF_CHECK(x->is_remote());
+        receivers.push_back(x.address());
+      }
+      auto ptr = actor_cast<abstract_actor_ptr>(xs.front());
+      auto fwd = dynamic_cast<forwarding_actor_proxy*>(ptr.get());
+      CAF_CHECK(fwd != nullptr);
+      if (fwd == nullptr) {
+        self->quit(exit_reason::user_defined);
+        return;
+      }
+      // the same message a local group sends to its remote acquaintances
+      anon_send(fwd->manager(), atom("_Multicast"), self->address(),
+                std::move(receivers), make_message(string{"hello"}, 42));
+    },
+    [=](ok_atom, const string& str, int value) {
+      CAF_CHECK_EQUAL(str, "hello");
+      CAF_CHECK_EQUAL(value, 42);
+      if (++*replies == num_receivers) {
+        self->send(buddy, ok_atom::value);
+        self->quit();
+      }
+    },
+    after(chrono::seconds(10)) >> [=] {
+      CAF_UNEXPECTED_TOUT();
+      self->quit(exit_reason::user_defined);
+    }
+  };
+}
+
+void run_client(const char* host, uint16_t port) {
+  scoped_actor self;
+  auto serv = io::remote_actor(host, port);
+  actor_vector receivers;
+  for (size_t i = 0; i < num_receivers; ++i) {
+    receivers.push_back(self->spawn<monitored>(receiver));
+  }
+  self->send(serv, receivers);
+  size_t i = 0;
+  self->receive_for(i, num_receivers) (
+    [&](const down_msg& dm) {
+      CAF_CHECK_EQUAL(dm.reason, exit_reason::normal);
+    },
+    after(chrono::seconds(10)) >> [] {
+      CAF_UNEXPECTED_TOUT();
+    }
+  );
+}
+
+void test_remote_multicast(const char* app_path) {
+  CAF_PRINT("test_remote_multicast");
+  scoped_actor self;
+  actor buddy = self;
+  auto port = io::publish(spawn(collector, buddy), 0, "127.0.0.1");
+  CAF_CHECK(port > 0);
+  auto child = run_program(self, app_path, "-c", port);
+  self->receive(
+    [](ok_atom) {
+      CAF_CHECKPOINT();
+    },
+    after(chrono::seconds(10)) >> [] {
+      CAF_UNEXPECTED_TOUT();
+    }
+  );
+  child.join();
+  self->receive(
+    [](const string& output) {
+      cout << endl << endl << "*** output of client program ***"
+           << endl << output << endl;
+    }
+  );
+  self->await_all_other_actors_done();
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  CAF_TEST(test_remote_multicast);
+  announce<actor_vector>("actor_vector");
+  message_builder{argv + 1, argv + argc}.apply({
+    on("-c", spro<uint16_t>) >> [](uint16_t port) {
+      CAF_PRINT("run in client mode");
+      run_client("localhost", port);
+    },
+    on() >> [&] {
+      test_remote_multicast(argv[0]);
+    }
+  });
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
@@ -0,0 +1,62 @@
+#include <cstdio>
+#include <string>
+#include <fstream>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/scheduler/sampling_coordinator.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr const char* filename = "test_sampling_coordinator.json";
+
+behavior ping(event_based_actor* self, int num_pings) {
+  return {
+    [=](int x) {
+      if (x >= num_pings) {
+        self->quit();
+      }
+      return x + 1;
+    }
+  };
+}
+
+void test_samples() {
+  CAF_PRINT("test_samples");
+  auto a = spawn(ping, 1000);
+  auto b = spawn(ping, 1000);
+  send_as(b, a, 1);
+  await_all_actors_done();
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_sampling_coordinator);
+  using coordinator_type = scheduler::sampling_coordinator<>;
+  // sample each resume and aggregate every 10ms
+  set_scheduler(new coordinator_type{filename, 1, std::chrono::milliseconds{10},
+                                     2});
+  test_samples();
+  shutdown();
+  std::ifstream in{filename};
+  std::string line;
+  size_t worker_lines = 0;
+  size_t actor_lines = 0;
+  while (std::getline(in, line)) {
+    CAF_CHECK(line.front() == '{' && line.back() == '}');
+    if (line.find("\"type\":\"worker\"") != std::string::npos) {
+      ++worker_lines;
+    } else if (line.find("\"type\":\"actor\"") != std::string::npos) {
+      ++actor_lines;
+    }
+  }
+  CAF_CHECK(worker_lines >= 2);
+  CAF_CHECK(actor_lines >= 2);
+  in.close();
+  std::remove(filename);
+  return CAF_TEST_RESULT();
+}
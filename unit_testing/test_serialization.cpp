@@ -68,6 +68,35 @@ struct struct_c {
   set<int> ints;
 };
 
+// announced with reversed member order
+struct struct_d {
+  int8_t x;
+  int64_t y;
+};
+
+// integer members with padding in between
+struct struct_e {
+  int8_t x;
+  int32_t y;
+};
+
+struct pad_base {
+  int64_t pad;
+};
+
+struct int_base {
+  int32_t y;
+};
+
+// `y` is inherited from a base at a non-zero offset
+struct struct_f : pad_base, int_base {
+  int32_t z;
+};
+
+bool operator==(const struct_f& lhs, const struct_f& rhs) {
+  return lhs.y == rhs.y && lhs.z == rhs.z;
+}
+
 struct raw_struct {
   string str;
 };
@@ -131,6 +160,68 @@ void test_string_serialization() {
   CAF_CHECK_EQUAL(to_string(*m), to_string(input));
 }
 
+void test_binary_serialization() {
+  auto input = make_message(struct_a{1, 2}, struct_d{3, 4}, int16_t{5},
+                            3.5, "six");
+  vector<char> buf;
+  binary_serializer bs{&buf};
+  bs << input;
+  binary_deserializer bd{buf.data(), buf.size()};
+  message output;
+  uniform_typeid<message>()->deserialize(&output, &bd);
+  output.apply({
+    [](const struct_a& a, const struct_d& d, int16_t i, double f,
+       const string& str) {
+      CAF_CHECK_EQUAL(a.x, 1);
+      CAF_CHECK_EQUAL(a.y, 2);
+      CAF_CHECK_EQUAL(d.x, 3);
+      CAF_CHECK_EQUAL(d.y, 4);
+      CAF_CHECK_EQUAL(i, 5);
+      CAF_CHECK_EQUAL(f, 3.5);
+      CAF_CHECK_EQUAL(str, "six");
+    },
+    others >> [&] {
+      CAF_FAILURE("unexpected message: " << to_string(output));
+    }
+  });
+  CAF_CHECK(output == input);
+  // modifying a shared message detaches, i.e., copies, its data
+  auto copy = output;
+  copy.get_as_mutable<int16_t>(2) = 6;
+  CAF_CHECK_EQUAL(output.get_as<int16_t>(2), 5);
+  CAF_CHECK_EQUAL(copy.get_as<int16_t>(2), 6);
+  CAF_CHECK_EQUAL(copy.get_as<string>(4), "six");
+}
+
+// `size` is the sum of all member sizes, i.e., excludes padding
+template <class T>
+T raw_round_trip(const T& x, size_t size) {
+  vector<char> buf;
+  binary_serializer bs{&buf};
+  uniform_typeid<T>()->serialize(&x, &bs);
+  CAF_CHECK_EQUAL(buf.size(), size);
+  binary_deserializer bd{buf.data(), buf.size()};
+  T result;
+  uniform_typeid<T>()->deserialize(&result, &bd);
+  return result;
+}
+
+void test_raw_members() {
+  auto d = raw_round_trip(struct_d{1, 2}, 9);
+  CAF_CHECK_EQUAL(d.x, 1);
+  CAF_CHECK_EQUAL(d.y, 2);
+  auto e = raw_round_trip(struct_e{3, 4}, 5);
+  CAF_CHECK_EQUAL(e.x, 3);
+  CAF_CHECK_EQUAL(e.y, 4);
+  struct_f f;
+  f.pad = 5;
+  f.y = 6;
+  f.z = 7;
+  auto g = raw_round_trip(f, 8);
+  CAF_CHECK_EQUAL(g.y, 6);
+  CAF_CHECK_EQUAL(g.z, 7);
+}
+
 int main() {
   CAF_TEST(test_serialization);
 
@@ -159,6 +250,13 @@ int main() {
 
   test_string_serialization();
 
+  announce<struct_a>("struct_a", &struct_a::x, &struct_a::y);
+  announce<struct_d>("struct_d", &struct_d::y, &struct_d::x);
+  test_binary_serialization();
+  announce<struct_e>("struct_e", &struct_e::x, &struct_e::y);
+  announce<struct_f>("struct_f", &struct_f::y, &struct_f::z);
+  test_raw_members();
+
   /*
     auto oarr = new detail::object_array;
     oarr->push_back(object::from(static_cast<uint32_t>(42)));
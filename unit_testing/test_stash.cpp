@@ -0,0 +1,178 @@
+#include <vector>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+using go_atom = atom_constant<atom("go")>;
+using done_atom = atom_constant<atom("done")>;
+using tick_atom = atom_constant<atom("tick")>;
+
+constexpr int num_msgs = 1000;
+
+void test_rematch_on_become() {
+  CAF_PRINT("test_rematch_on_become");
+  scoped_actor self;
+  actor buddy = self;
+  auto testee = spawn([=](event_based_actor* ptr) -> behavior {
+    auto xs = std::make_shared<std::vector<int>>();
+    return {
+      [=](go_atom) {
+        ptr->become(
+          [=](int x) {
+            xs->push_back(x);
+          },
+          [=](done_atom) {
+            ptr->send(buddy, *xs);
+            ptr->quit();
+          }
+        );
+      }
+    };
+  });
+  // all messages except 'go' are skipped by the initial behavior
+  for (int i = 0; i < num_msgs; ++i) {
+    self->send(testee, i);
+  }
+  self->send(testee, done_atom::value);
+  self->send(testee, go_atom::value);
+  self->receive(
+    [](const std::vector<int>& xs) {
+      CAF_CHECK_EQUAL(xs.size(), static_cast<size_t>(num_msgs));
+      bool in_order = true;
+      for (int i = 0; i < num_msgs; ++i) {
+        if (xs[static_cast<size_t>(i)] != i) {
+          in_order = false;
+        }
+      }
+      CAF_CHECK(in_order);
+    }
+  );
+}
+
+void test_skip_heavy() {
+  CAF_PRINT("test_skip_heavy");
+  scoped_actor self;
+  actor buddy = self;
+  auto testee = spawn([=](event_based_actor* ptr) -> behavior {
+    auto skips = std::make_shared<int>(0);
+    auto received = std::make_shared<int>(0);
+    return {
+      [=](int) {
+        ++*skips;
+        return skip_message();
+      },
+      [=](tick_atom) {
+        // handled without changing the behavior
+      },
+      [=](go_atom) {
+        ptr->become(
+          [=](int) {
+            ++*received;
+          },
+          [=](done_atom) {
+            ptr->send(buddy, *skips, *received);
+            ptr->quit();
+          }
+        );
+      }
+    };
+  });
+  for (int i = 0; i < num_msgs; ++i) {
+    self->send(testee, i);
+  }
+  for (int i = 0; i < num_msgs; ++i) {
+    self->send(testee, tick_atom::value);
+  }
+  self->send(testee, done_atom::value);
+  self->send(testee, go_atom::value);
+  self->receive(
+    [](int skips, int received) {
+      // the first tick checks the stash once, i.e., each integer is skipped
+      // at most twice rather than once per handled tick
+      CAF_CHECK(skips <= 2 * num_msgs);
+      CAF_CHECK_EQUAL(received, num_msgs);
+    }
+  );
+}
+
+void test_exit_msg_while_awaiting_response() {
+  CAF_PRINT("test_exit_msg_while_awaiting_response");
+  scoped_actor self;
+  // never answers, i.e., the testee awaits its response forever
+  auto server = spawn([](event_based_actor* ptr) -> behavior {
+    return {
+      [=](go_atom) {
+        ptr->make_response_promise();
+      }
+    };
+  });
+  auto testee = spawn([=](event_based_actor* ptr) -> behavior {
+    ptr->trap_exit(true);
+    return {
+      [=](go_atom) {
+        // the stashed exit message must be handled while awaiting
+        ptr->trap_exit(false);
+        ptr->sync_send(server, go_atom::value).then(
+          [](int) {
+            // nop
+          }
+        );
+      },
+      [=](int) {
+        // nop
+      }
+    };
+  });
+  self->monitor(testee);
+  self->send_exit(testee, exit_reason::user_defined);
+  self->send(testee, go_atom::value);
+  self->receive(
+    [&](const down_msg& dm) {
+      CAF_CHECK_EQUAL(dm.reason, exit_reason::user_defined);
+    }
+  );
+  anon_send_exit(server, exit_reason::user_shutdown);
+}
+
+void test_stashed_exit_msg() {
+  CAF_PRINT("test_stashed_exit_msg");
+  scoped_actor self;
+  auto testee = spawn([](event_based_actor* ptr) -> behavior {
+    ptr->trap_exit(true);
+    return {
+      [=](go_atom) {
+        // the stashed exit message becomes a non-normal exit signal now
+        ptr->trap_exit(false);
+      },
+      [=](int) {
+        // nop
+      }
+    };
+  });
+  self->monitor(testee);
+  self->send_exit(testee, exit_reason::user_defined);
+  self->send(testee, go_atom::value);
+  self->receive(
+    [&](const down_msg& dm) {
+      CAF_CHECK_EQUAL(dm.reason, exit_reason::user_defined);
+    }
+  );
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_stash);
+  test_rematch_on_become();
+  test_skip_heavy();
+  test_stashed_exit_msg();
+  test_exit_msg_while_awaiting_response();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
@@ -0,0 +1,135 @@
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+#include "caf/io/network/default_multiplexer.hpp"
+
+using namespace caf;
+using namespace caf::io;
+
+namespace {
+
+// exceeds the socket buffers, i.e., requires many partial writes
+constexpr size_t chunk_size = 4096;
+constexpr size_t num_chunks = 1024;
+
+char chunk_value(size_t chunk) {
+  return static_cast<char>(chunk % 251);
+}
+
+std::string read_exactly(int fd, size_t len) {
+  std::string result(len, '\0');
+  size_t pos = 0;
+  while (pos < len) {
+    auto res = ::read(fd, &result[pos], len - pos);
+    if (res <= 0) {
+      result.resize(pos);
+      return result;
+    }
+    pos += static_cast<size_t>(res);
+  }
+  return result;
+}
+
+void test_gather_write() {
+  CAF_PRINT("test_gather_write");
+  int fds[2];
+  CAF_CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  size_t written = 0;
+  // both buffers leave in one write
+  CAF_CHECK(network::write_some(written, fds[0], "hello ", 6, "world", 5));
+  CAF_CHECK_EQUAL(written, 11);
+  CAF_CHECK_EQUAL(read_exactly(fds[1], 11), "hello world");
+  // an empty buffer falls back to a regular write
+  CAF_CHECK(network::write_some(written, fds[0], "", 0, "foo", 3));
+  CAF_CHECK_EQUAL(written, 3);
+  CAF_CHECK(network::write_some(written, fds[0], "bar", 3, "", 0));
+  CAF_CHECK_EQUAL(written, 3);
+  CAF_CHECK_EQUAL(read_exactly(fds[1], 6), "foobar");
+  close(fds[0]);
+  close(fds[1]);
+}
+
+// writes all chunks at once and flushes after each one, i.e., later
+// chunks pile up in the offline buffer while a write is pending
+behavior sender(broker* self, actor buddy) {
+  auto port = self->add_tcp_doorman(0, "127.0.0.1").second;
+  self->send(buddy, port);
+  return {
+    [=](const new_connection_msg& msg) {
+      // reading allows us to notice when the receiver closes the connection
+      self->configure_read(msg.handle, receive_policy::at_most(1));
+      for (size_t i = 0; i < num_chunks; ++i) {
+        auto& buf = self->wr_buf(msg.handle);
+        buf.insert(buf.end(), chunk_size, chunk_value(i));
+        self->flush(msg.handle);
+      }
+    },
+    [=](const connection_closed_msg&) {
+      self->quit();
+    }
+  };
+}
+
+behavior receiver(broker* self, connection_handle hdl, actor buddy) {
+  self->configure_read(hdl, receive_policy::exactly(chunk_size));
+  auto received = std::make_shared<size_t>(0);
+  return {
+    [=](const new_data_msg& msg) {
+      auto expected = chunk_value(*received);
+      auto ok = std::all_of(msg.buf.begin(), msg.buf.end(),
+                            [=](char x) { return x == expected; });
+      if (!ok) {
+        CAF_FAILURE("chunk " << *received << " is corrupted");
+        self->send(buddy, *received);
+        self->quit();
+        return;
+      }
+      if (++*received == num_chunks) {
+        self->send(buddy, *received);
+        self->quit();
+      }
+    }
+  };
+}
+
+void test_coalesced_writes() {
+  CAF_PRINT("test_coalesced_writes");
+  scoped_actor self;
+  actor buddy = self;
+  spawn_io(sender, buddy);
+  self->receive(
+    [&](uint16_t port) {
+      spawn_io_client(receiver, "127.0.0.1", port, buddy);
+    }
+  );
+  self->receive(
+    [](size_t received) {
+      CAF_CHECK_EQUAL(received, num_chunks);
+    },
+    after(std::chrono::seconds(10)) >> [] {
+      CAF_UNEXPECTED_TOUT();
+    }
+  );
+  self->await_all_other_actors_done();
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_stream_write);
+  test_gather_write();
+  test_coalesced_writes();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
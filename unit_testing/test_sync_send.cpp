@@ -400,11 +400,59 @@ void test_sync_send() {
   );
 }
 
+// delivers a response promise from another actor after the promising actor
+// is done, i.e., from a thread that does not run the promising actor
+void test_foreign_delivery() {
+  CAF_PRINT("test_foreign_delivery");
+  constexpr int num_requests = 1000;
+  auto promising = [](event_based_actor* self) -> behavior {
+    return {
+      [=](int x) {
+        auto rp = self->make_response_promise();
+        auto deliverer = spawn([=](event_based_actor* ptr) -> behavior {
+          return {
+            [=](int y) {
+              rp.deliver(make_message(y * 2));
+              ptr->quit();
+            }
+          };
+        });
+        self->send(deliverer, x);
+        self->quit();
+      }
+    };
+  };
+  scoped_actor self;
+  actor buddy = self;
+  for (int i = 0; i < num_requests; ++i) {
+    spawn([=](event_based_actor* ptr) {
+      ptr->sync_send(spawn(promising), i).then(
+        [=](int x) {
+          ptr->send(buddy, x);
+          ptr->quit();
+        }
+      );
+    });
+  }
+  int sum = 0;
+  int i = 0;
+  self->receive_for(i, num_requests) (
+    [&](int x) {
+      sum += x;
+    },
+    after(std::chrono::seconds(10)) >> [] {
+      CAF_UNEXPECTED_TOUT();
+    }
+  );
+  CAF_CHECK_EQUAL(sum, num_requests * (num_requests - 1));
+}
+
 } // namespace <anonymous>
 
 int main() {
   CAF_TEST(test_sync_send);
   test_sync_send();
+  test_foreign_delivery();
   await_all_actors_done();
   CAF_CHECKPOINT();
   shutdown();
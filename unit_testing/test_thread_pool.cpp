@@ -0,0 +1,113 @@
+#include <limits>
+#include <thread>
+#include <chrono>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/scheduler/thread_pool.hpp"
+
+using namespace caf;
+
+namespace {
+
+using std::chrono::milliseconds;
+
+constexpr size_t unbounded = std::numeric_limits<size_t>::max();
+
+scheduler::thread_pool& pool() {
+  return *detail::singletons::get_blocking_pool();
+}
+
+template <class Predicate>
+bool await_stats(Predicate pred) {
+  for (int i = 0; i < 1000; ++i) {
+    if (pred(pool().statistics())) {
+      return true;
+    }
+    std::this_thread::sleep_for(milliseconds(5));
+  }
+  return false;
+}
+
+behavior echo(event_based_actor* self) {
+  return {
+    [=](int x) {
+      self->quit();
+      return x;
+    }
+  };
+}
+
+void test_reuse(size_t printer_threads) {
+  CAF_PRINT("test_reuse");
+  pool().configure(0, unbounded, milliseconds(1000));
+  scoped_actor self;
+  for (int i = 0; i < 10; ++i) {
+    self->sync_send(spawn<detached>(echo), i).await(
+      [&](int x) {
+        CAF_CHECK_EQUAL(x, i);
+      }
+    );
+    // wait until the thread became available again
+    CAF_CHECK(await_stats([](const scheduler::thread_pool::stats& st) {
+      return st.idle > 0;
+    }));
+  }
+  CAF_CHECK(pool().statistics().peak_threads <= printer_threads + 1);
+}
+
+void test_idle_timeout(size_t printer_threads) {
+  CAF_PRINT("test_idle_timeout");
+  pool().configure(0, unbounded, milliseconds(10));
+  CAF_CHECK(await_stats([&](const scheduler::thread_pool::stats& st) {
+    return st.threads == printer_threads;
+  }));
+}
+
+void test_saturation(size_t printer_threads) {
+  CAF_PRINT("test_saturation");
+  pool().configure(0, printer_threads + 1, milliseconds(1000));
+  auto saturated = pool().statistics().saturated;
+  auto a = spawn<detached>(echo);
+  auto b = spawn<detached>(echo);
+  auto st = pool().statistics();
+  CAF_CHECK_EQUAL(st.saturated, saturated + 1);
+  // tasks wait only until their freshly spawned thread picks them up
+  CAF_CHECK(await_stats([](const scheduler::thread_pool::stats& x) {
+    return x.queued == 0;
+  }));
+  scoped_actor self;
+  // b runs in a surplus thread, i.e., both actors run concurrently
+  self->send(b, 2);
+  self->receive(
+    [](int x) {
+      CAF_CHECK_EQUAL(x, 2);
+    }
+  );
+  self->send(a, 1);
+  self->receive(
+    [](int x) {
+      CAF_CHECK_EQUAL(x, 1);
+    }
+  );
+  // the surplus thread terminates instead of staying in the pool
+  CAF_CHECK(await_stats([&](const scheduler::thread_pool::stats& x) {
+    return x.threads <= printer_threads + 1;
+  }));
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_thread_pool);
+  // the printer of the scheduler is a detached actor
+  detail::singletons::get_scheduling_coordinator();
+  auto printer_threads = pool().statistics().threads;
+  test_reuse(printer_threads);
+  test_idle_timeout(printer_threads);
+  test_saturation(printer_threads);
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
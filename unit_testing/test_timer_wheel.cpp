@@ -0,0 +1,160 @@
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/detail/singletons.hpp"
+#include "caf/detail/timer_wheel.hpp"
+#include "caf/scheduler/abstract_coordinator.hpp"
+
+using namespace caf;
+
+using detail::timer_wheel;
+
+namespace {
+
+struct timer : timer_wheel::node {
+  uint64_t expired_at = 0;
+};
+
+void test_expiry() {
+  CAF_PRINT("test_expiry");
+  timer_wheel wheel;
+  CAF_CHECK(wheel.empty());
+  CAF_CHECK(wheel.next_event() == timer_wheel::infinite);
+  // deadlines on all levels, including out-of-range deadlines
+  std::vector<uint64_t> deadlines{0, 1, 2, 63, 64, 65, 4095, 4096, 4097,
+                                  100000, 262143, 262144, 1ull << 30,
+                                  (1ull << 36) + 5, (1ull << 40) + 7};
+  std::vector<timer> timers(deadlines.size());
+  for (size_t i = 0; i < timers.size(); ++i) {
+    timers[i].deadline(deadlines[i]);
+    wheel.insert(&timers[i]);
+  }
+  CAF_CHECK_EQUAL(wheel.size(), timers.size());
+  size_t num_expired = 0;
+  bool in_order = true;
+  uint64_t last = 0;
+  auto f = [&](timer_wheel::node* ptr) {
+    auto t = static_cast<timer*>(ptr);
+    t->expired_at = wheel.now();
+    in_order = in_order && wheel.now() >= last;
+    last = wheel.now();
+    ++num_expired;
+  };
+  wheel.advance(4096, f);
+  CAF_CHECK_EQUAL(num_expired, 8);
+  wheel.advance(1ull << 41, f);
+  CAF_CHECK_EQUAL(num_expired, timers.size());
+  CAF_CHECK(wheel.empty());
+  CAF_CHECK(in_order);
+  // a deadline of 0 expires on the first tick
+  CAF_CHECK_EQUAL(timers[0].expired_at, 1);
+  size_t wrong = 0;
+  for (size_t i = 1; i < timers.size(); ++i) {
+    if (timers[i].expired_at != deadlines[i]) {
+      ++wrong;
+    }
+  }
+  CAF_CHECK_EQUAL(wrong, 0);
+}
+
+void test_erase() {
+  CAF_PRINT("test_erase");
+  timer_wheel wheel{1000};
+  std::vector<timer> timers(1000);
+  std::default_random_engine re{42};
+  std::uniform_int_distribution<uint64_t> dist{1001, 100000};
+  for (auto& t : timers) {
+    t.deadline(dist(re));
+    wheel.insert(&t);
+  }
+  for (size_t i = 0; i < timers.size(); i += 2) {
+    wheel.erase(&timers[i]);
+    CAF_CHECK(!timers[i].linked());
+  }
+  CAF_CHECK_EQUAL(wheel.size(), 500);
+  size_t wrong = 0;
+  wheel.advance(100000, [&](timer_wheel::node* ptr) {
+    if (ptr->deadline() != wheel.now()) {
+      ++wrong;
+    }
+    static_cast<timer*>(ptr)->expired_at = wheel.now();
+  });
+  CAF_CHECK_EQUAL(wrong, 0);
+  CAF_CHECK(wheel.empty());
+  auto expired = std::count_if(timers.begin(), timers.end(),
+                               [](const timer& t) { return t.expired_at != 0; });
+  CAF_CHECK_EQUAL(expired, 500);
+}
+
+void test_delayed_send() {
+  CAF_PRINT("test_delayed_send");
+  scoped_actor self;
+  auto start = std::chrono::steady_clock::now();
+  self->delayed_send(self, std::chrono::milliseconds(50), 2);
+  self->delayed_send(self, std::chrono::milliseconds(10), 1);
+  self->delayed_send(self, std::chrono::milliseconds(100), 3);
+  std::vector<int> received;
+  int i = 0;
+  self->receive_for(i, 3) (
+    [&](int x) {
+      received.push_back(x);
+    }
+  );
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  CAF_CHECK((received == std::vector<int>{1, 2, 3}));
+  CAF_CHECK(elapsed >= std::chrono::milliseconds(100));
+}
+
+void test_cancel() {
+  CAF_PRINT("test_cancel");
+  scoped_actor self;
+  auto sched = detail::singletons::get_scheduling_coordinator();
+  auto hdl = sched->delayed_send(std::chrono::milliseconds(10),
+                                 self->address(), self, message_id::make(),
+                                 make_message(1));
+  CAF_CHECK(sched->timers().cancel(hdl));
+  CAF_CHECK(!sched->timers().cancel(hdl));
+  self->delayed_send(self, std::chrono::milliseconds(50), 2);
+  self->receive(
+    [](int x) {
+      CAF_CHECK_EQUAL(x, 2);
+    }
+  );
+  // an idle timeout that gets re-armed on each message never fires
+  auto timeouts = std::make_shared<int>(0);
+  auto testee = spawn([=](event_based_actor* ptr) -> behavior {
+    return {
+      [=](int x) {
+        if (x == 0) {
+          ptr->quit();
+        }
+      },
+      after(std::chrono::milliseconds(500)) >> [=] {
+        ++*timeouts;
+      }
+    };
+  });
+  for (int i = 10; i >= 0; --i) {
+    self->send(testee, i);
+  }
+  self->await_all_other_actors_done();
+  CAF_CHECK_EQUAL(*timeouts, 0);
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_timer_wheel);
+  test_expiry();
+  test_erase();
+  test_delayed_send();
+  test_cancel();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}
@@ -0,0 +1,176 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+
+#include "caf/all.hpp"
+#include "caf/set_scheduler.hpp"
+#include "caf/policy/lock_free_work_stealing.hpp"
+#include "caf/detail/work_stealing_deque.hpp"
+
+using namespace caf;
+
+using deque_type = detail::work_stealing_deque<int>;
+
+namespace {
+
+void test_owner_operations() {
+  CAF_PRINT("test_owner_operations");
+  std::vector<int> xs(100);
+  deque_type q{4};
+  CAF_CHECK(q.empty());
+  CAF_CHECK(q.pop_bottom() == nullptr);
+  CAF_CHECK(q.steal() == nullptr);
+  for (auto& x : xs) {
+    q.push_bottom(&x);
+  }
+  CAF_CHECK_EQUAL(q.size(), 100);
+  CAF_CHECK(q.capacity() >= 100);
+  // the owner is LIFO, thieves are FIFO
+  CAF_CHECK(q.pop_bottom() == &xs[99]);
+  CAF_CHECK(q.steal() == &xs[0]);
+  CAF_CHECK(q.steal() == &xs[1]);
+  CAF_CHECK(q.pop_bottom() == &xs[98]);
+  CAF_CHECK_EQUAL(q.size(), 96);
+  while (q.pop_bottom() != nullptr) {
+    // nop
+  }
+  CAF_CHECK(q.empty());
+}
+
+void test_concurrent_steal() {
+  CAF_PRINT("test_concurrent_steal");
+  constexpr int num_elements = 100000;
+  constexpr int num_thieves = 3;
+  std::vector<int> xs(num_elements);
+  std::vector<std::atomic<int>> taken(num_elements);
+  for (auto& x : taken) {
+    x = 0;
+  }
+  deque_type q;
+  std::atomic<bool> done{false};
+  auto take = [&](int* ptr) {
+    ++taken[static_cast<size_t>(ptr - xs.data())];
+  };
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < num_thieves; ++i) {
+    thieves.emplace_back([&] {
+      while (!done || !q.empty()) {
+        auto ptr = q.steal();
+        if (ptr) {
+          take(ptr);
+        }
+      }
+    });
+  }
+  for (int i = 0; i < num_elements; ++i) {
+    q.push_bottom(&xs[static_cast<size_t>(i)]);
+    if (i % 3 == 0) {
+      auto ptr = q.pop_bottom();
+      if (ptr) {
+        take(ptr);
+      }
+    }
+  }
+  done = true;
+  for (auto& t : thieves) {
+    t.join();
+  }
+  for (auto ptr = q.pop_bottom(); ptr != nullptr; ptr = q.pop_bottom()) {
+    take(ptr);
+  }
+  size_t errors = 0;
+  for (auto& x : taken) {
+    if (x != 1) {
+      ++errors;
+    }
+  }
+  CAF_CHECK_EQUAL(errors, 0);
+}
+
+void test_scheduler_policy() {
+  CAF_PRINT("test_scheduler_policy");
+  set_scheduler<policy::lock_free_work_stealing>(4);
+  constexpr int num_actors = 100;
+  scoped_actor self;
+  for (int i = 0; i < num_actors; ++i) {
+    auto worker = spawn([](event_based_actor* ptr) -> behavior {
+      return {
+        [=](int x) {
+          ptr->quit();
+          return x * 2;
+        }
+      };
+    });
+    self->send(worker, i);
+  }
+  int sum = 0;
+  int i = 0;
+  self->receive_for(i, num_actors) (
+    [&](int x) {
+      sum += x;
+    }
+  );
+  CAF_CHECK_EQUAL(sum, num_actors * (num_actors - 1));
+}
+
+// delivers a response promise from another actor after the promising actor
+// is done, i.e., from a thread that does not run the promising actor
+void test_foreign_delivery() {
+  CAF_PRINT("test_foreign_delivery");
+  constexpr int num_requests = 1000;
+  auto promising = [](event_based_actor* self) -> behavior {
+    return {
+      [=](int x) {
+        auto rp = self->make_response_promise();
+        auto deliverer = spawn([=](event_based_actor* ptr) -> behavior {
+          return {
+            [=](int y) {
+              rp.deliver(make_message(y * 2));
+              ptr->quit();
+            }
+          };
+        });
+        self->send(deliverer, x);
+        self->quit();
+      }
+    };
+  };
+  scoped_actor self;
+  actor buddy = self;
+  for (int i = 0; i < num_requests; ++i) {
+    spawn([=](event_based_actor* ptr) {
+      ptr->sync_send(spawn(promising), i).then(
+        [=](int x) {
+          ptr->send(buddy, x);
+          ptr->quit();
+        }
+      );
+    });
+  }
+  int sum = 0;
+  int i = 0;
+  self->receive_for(i, num_requests) (
+    [&](int x) {
+      sum += x;
+    },
+    after(std::chrono::seconds(10)) >> [] {
+      CAF_UNEXPECTED_TOUT();
+    }
+  );
+  CAF_CHECK_EQUAL(sum, num_requests * (num_requests - 1));
+}
+
+} // namespace <anonymous>
+
+int main() {
+  CAF_TEST(test_work_stealing_deque);
+  test_owner_operations();
+  test_concurrent_steal();
+  test_scheduler_policy();
+  test_foreign_delivery();
+  await_all_actors_done();
+  shutdown();
+  return CAF_TEST_RESULT();
+}